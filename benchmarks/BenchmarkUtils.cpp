@@ -0,0 +1,97 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// The benchmarks' replacement global allocation functions. Every form of `new` counts its request and every form of
+// `delete` frees with the call that matches how the memory was obtained, so sized, array and aligned deletes all
+// pair with their `new`.
+//
+
+#include <cstdlib>
+#include <new>
+
+#include "BenchmarkUtils.h"
+
+namespace {
+
+void count(const std::size_t size) noexcept {
+  caset::bench::allocationCount.fetch_add(1, std::memory_order_relaxed);
+  caset::bench::allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void *allocate(const std::size_t size) noexcept {
+  count(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void *allocate(const std::size_t size, const std::align_val_t alignment) noexcept {
+  count(size);
+  const auto align = static_cast<std::size_t>(alignment);
+  // aligned_alloc wants a size that is a multiple of the alignment.
+  const std::size_t rounded = size == 0 ? align : (size + align - 1) / align * align;
+  return std::aligned_alloc(align, rounded);
+}
+
+} // namespace
+
+void *operator new(const std::size_t size) {
+  if (void *p = allocate(size)) return p;
+  throw std::bad_alloc();
+}
+
+void *operator new[](const std::size_t size) {
+  if (void *p = allocate(size)) return p;
+  throw std::bad_alloc();
+}
+
+void *operator new(const std::size_t size, const std::align_val_t alignment) {
+  if (void *p = allocate(size, alignment)) return p;
+  throw std::bad_alloc();
+}
+
+void *operator new[](const std::size_t size, const std::align_val_t alignment) {
+  if (void *p = allocate(size, alignment)) return p;
+  throw std::bad_alloc();
+}
+
+void *operator new(const std::size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+void *operator new[](const std::size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+
+void *operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t &) noexcept {
+  return allocate(size, alignment);
+}
+
+void *operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t &) noexcept {
+  return allocate(size, alignment);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
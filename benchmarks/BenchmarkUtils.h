@@ -0,0 +1,67 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// Shared helpers for the caset micro-benchmarks. Each benchmark is its own executable, linked with
+// BenchmarkUtils.cpp, which replaces the global allocation functions so `AllocationScope` has something to count.
+//
+
+#ifndef CASET_BENCHMARKUTILS_H
+#define CASET_BENCHMARKUTILS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace caset::bench {
+
+inline std::atomic<std::size_t> allocationCount{0};
+inline std::atomic<std::size_t> allocatedBytes{0};
+
+///
+/// Counts heap allocations (and the bytes requested) made between construction and `stop()`.
+class AllocationScope {
+  public:
+    AllocationScope() noexcept : count(allocationCount.load()), bytes(allocatedBytes.load()) {}
+
+    [[nodiscard]] std::size_t allocations() const noexcept { return allocationCount.load() - count; }
+    [[nodiscard]] std::size_t bytesAllocated() const noexcept { return allocatedBytes.load() - bytes; }
+
+  private:
+    std::size_t count;
+    std::size_t bytes;
+};
+
+class Stopwatch {
+  public:
+    Stopwatch() noexcept : start(std::chrono::steady_clock::now()) {}
+
+    [[nodiscard]] double seconds() const noexcept {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+  private:
+    std::chrono::steady_clock::time_point start;
+};
+
+} // caset::bench
+
+#endif //CASET_BENCHMARKUTILS_H
@@ -0,0 +1,84 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// Measures the cost of one gluing step (choose + attach) as the complex grows. Each row glues a window of simplices
+// onto a complex that has doubled in size since the previous row; with the boundary indexed by free facet the per-step
+// cost should stay flat rather than grow with the boundary.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <tuple>
+
+#include "BenchmarkUtils.h"
+#include "spacetime/Spacetime.h"
+
+using namespace caset;
+
+int main(int argc, char **argv) {
+  const int maxSize = argc > 1 ? std::atoi(argv[1]) : 64000;
+  const int window = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+  Spacetime spacetime{};
+  spacetime.seed(0);
+  const std::tuple<uint8_t, uint8_t> orientations[] = {{1, 2}, {2, 1}};
+  spacetime.createSimplex(orientations[1]);
+
+  std::printf("%10s %12s %12s %14s\n", "simplices", "choose us", "attach us", "allocs/step");
+  int size = 1;
+  for (int checkpoint = window; checkpoint <= maxSize; checkpoint *= 2) {
+    // Grow to the checkpoint untimed, then time a window of steps at that size.
+    for (; size < checkpoint; size++) {
+      const SimplexPtr simplex = spacetime.createSimplex(orientations[size % 2]);
+      const auto faces = spacetime.chooseSimplexFacesToGlue(simplex);
+      if (!faces.has_value()) {
+        std::printf("No gluable faces at %d simplices.\n", size);
+        return 1;
+      }
+      spacetime.causallyAttachFaces(faces->first, faces->second);
+    }
+
+    double chooseSeconds = 0, attachSeconds = 0;
+    std::size_t allocations = 0;
+    for (int i = 0; i < window; i++, size++) {
+      const SimplexPtr simplex = spacetime.createSimplex(orientations[size % 2]);
+      bench::AllocationScope scope{};
+      bench::Stopwatch choose{};
+      const auto faces = spacetime.chooseSimplexFacesToGlue(simplex);
+      chooseSeconds += choose.seconds();
+      if (!faces.has_value()) {
+        std::printf("No gluable faces at %d simplices.\n", size);
+        return 1;
+      }
+      bench::Stopwatch attach{};
+      spacetime.causallyAttachFaces(faces->first, faces->second);
+      attachSeconds += attach.seconds();
+      allocations += scope.allocations();
+    }
+    std::printf("%10d %12.2f %12.2f %14.1f\n",
+                checkpoint,
+                1e6 * chooseSeconds / window,
+                1e6 * attachSeconds / window,
+                static_cast<double>(allocations) / window);
+  }
+  return 0;
+}
@@ -0,0 +1,70 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// Time to save a 2D strip built with Spacetime::buildSlabs to a checkpoint and load it back.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "spacetime/Checkpoint.h"
+#include "spacetime/Spacetime.h"
+
+using namespace caset;
+
+int main(int argc, char **argv) {
+  const int slabs = argc > 1 ? std::atoi(argv[1]) : 64;
+  const int perSlab = argc > 2 ? std::atoi(argv[2]) : 16001;
+  const std::string path = argc > 3 ? argv[3] : "caset-checkpoint.bin";
+
+  std::vector<std::tuple<uint8_t, uint8_t> > schedule{{2, 1}};
+  for (int i = 0; i < perSlab; i++) schedule.emplace_back(i % 2 == 0 ? std::make_tuple(1, 2) : std::make_tuple(2, 1));
+  const auto spacetime = std::make_shared<Spacetime>();
+  spacetime->seed(1);
+  bench::Stopwatch build{};
+  spacetime->buildSlabs(schedule, slabs);
+  const double buildSeconds = build.seconds();
+  std::printf("%zu simplices, %zu vertices, %zu edges: built in %.3f s\n", spacetime->getFaceCount(2),
+              spacetime->getVertexList()->size(), spacetime->getEdgeList()->size(), buildSeconds);
+
+  bench::Stopwatch save{};
+  spacetime->save(path);
+  const double saveSeconds = save.seconds();
+  bench::Stopwatch validate{};
+  const std::size_t bytes = Checkpoint(path).getFileSize();
+  const double validateSeconds = validate.seconds();
+  bench::Stopwatch load{};
+  const auto restored = Spacetime::load(path);
+  const double loadSeconds = load.seconds();
+  if (restored->getFVector() != spacetime->getFVector()) {
+    std::printf("the restored Spacetime has a different f-vector\n");
+    return 1;
+  }
+  std::printf("%.1f MB: saved in %.3f s, validated in %.3f s, loaded in %.3f s\n", static_cast<double>(bytes) / 1e6,
+              saveSeconds, validateSeconds, loadSeconds);
+  return 0;
+}
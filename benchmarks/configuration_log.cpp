@@ -0,0 +1,83 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// What logging every sweep of a 2D chain costs the chain, and how small the log is.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "simulations/CDT.h"
+#include "spacetime/ConfigurationLog.h"
+#include "spacetime/Spacetime.h"
+
+using namespace caset;
+
+int main(int argc, char **argv) {
+  const int slabs = argc > 1 ? std::atoi(argv[1]) : 4;
+  const int perSlab = argc > 2 ? std::atoi(argv[2]) : 2001;
+  const int frames = argc > 3 ? std::atoi(argv[3]) : 100;
+  const std::string path = argc > 4 ? argv[4] : "caset-configurations.bin";
+
+  std::vector<std::tuple<uint8_t, uint8_t> > schedule{{2, 1}};
+  for (int i = 0; i < perSlab; i++) schedule.emplace_back(i % 2 == 0 ? std::make_tuple(1, 2) : std::make_tuple(2, 1));
+  const auto spacetime = std::make_shared<Spacetime>();
+  spacetime->seed(1);
+  spacetime->buildSlabs(schedule, slabs);
+  CDT cdt(spacetime);
+  cdt.seed(1);
+  const std::size_t attempts = spacetime->getFaceCount(2);
+
+  double sweepSeconds = 0, appendSeconds = 0, closeSeconds = 0;
+  {
+    ConfigurationLog log(path);
+    for (int frame = 0; frame < frames; frame++) {
+      bench::Stopwatch sweep{};
+      cdt.sweep(attempts);
+      sweepSeconds += sweep.seconds();
+      bench::Stopwatch append{};
+      log.append(*spacetime, frame);
+      appendSeconds += append.seconds();
+    }
+    bench::Stopwatch close{};
+    log.close();
+    closeSeconds = close.seconds();
+  }
+
+  bench::Stopwatch read{};
+  ConfigurationReader reader(path);
+  std::size_t simplices = 0;
+  for (std::size_t i = 0; i < reader.size(); i++) simplices += reader.getFrame(i).orientations.size() / 2;
+  const double readSeconds = read.seconds();
+  const auto bytes = static_cast<double>(std::filesystem::file_size(path));
+  std::printf("%d frames of %zu simplices on average: %.2f bytes per simplex (%.1f MB)\n", frames,
+              simplices / reader.size(), bytes / static_cast<double>(simplices), bytes / 1e6);
+  std::printf("sweeps %.3f s, appends %.3f s (%.1f%% of the chain), drained on close in %.3f s, read back in %.3f s\n",
+              sweepSeconds, appendSeconds, 100. * appendSeconds / sweepSeconds, closeSeconds, readSeconds);
+  return 0;
+}
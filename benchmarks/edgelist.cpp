@@ -0,0 +1,81 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// Times EdgeList lookups, re-adds of existing edges and remove/add cycles, and counts the heap allocations they make.
+// None of them should allocate once the list has been populated.
+//
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "BenchmarkUtils.h"
+#include "EdgeList.h"
+
+using namespace caset;
+
+namespace {
+template<typename F>
+void report(const char *name, int operations, F &&f) {
+  bench::AllocationScope scope{};
+  bench::Stopwatch stopwatch{};
+  f();
+  const double seconds = stopwatch.seconds();
+  std::printf("  %-8s %8.1f ns/op  %8.3f allocations/op\n",
+              name,
+              1e9 * seconds / operations,
+              static_cast<double>(scope.allocations()) / operations);
+}
+}
+
+int main(int argc, char **argv) {
+  const int numEdges = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+  EdgeList edgeList{};
+  for (int i = 0; i < numEdges; i++) {
+    edgeList.add(static_cast<IdType>(i), static_cast<IdType>(i) + 1, 1.);
+  }
+
+  std::printf("EdgeList with %d edges\n", numEdges);
+  std::size_t found = 0;
+  report("get", numEdges, [&] {
+    for (int i = 0; i < numEdges; i++) {
+      if (edgeList.get({static_cast<IdType>(i), static_cast<IdType>(i) + 1}) != nullptr) found++;
+    }
+  });
+  report("re-add", numEdges, [&] {
+    for (int i = 0; i < numEdges; i++) {
+      if (edgeList.add(static_cast<IdType>(i), static_cast<IdType>(i) + 1, 1.) != nullptr) found++;
+    }
+  });
+  report("cycle", numEdges, [&] {
+    for (int i = 0; i < numEdges; i++) {
+      const auto edge = edgeList.get({static_cast<IdType>(i), static_cast<IdType>(i) + 1});
+      edgeList.remove(edge);
+      edgeList.add(edge);
+    }
+  });
+  if (found != 2 * static_cast<std::size_t>(numEdges) || edgeList.size() != static_cast<std::size_t>(numEdges)) {
+    std::printf("Unexpected EdgeList contents\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,88 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// Throughput of Spacetime::embed on a 2D strip built with Spacetime::buildSlabs, at one thread and at every thread,
+// without and with the same-slice repulsion. Built with CASET_WITH_TORCH, it also times both embedders to convergence
+// against the target of the native one being at least 10x faster than torch's.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "spacetime/Spacetime.h"
+
+using namespace caset;
+
+int main(int argc, char **argv) {
+  const int slabs = argc > 1 ? std::atoi(argv[1]) : 16;
+  const int perSlab = argc > 2 ? std::atoi(argv[2]) : 16001;
+  const int iterations = argc > 3 ? std::atoi(argv[3]) : 200;
+
+  std::vector<std::tuple<uint8_t, uint8_t> > schedule{{2, 1}};
+  for (int i = 0; i < perSlab; i++) schedule.emplace_back(i % 2 == 0 ? std::make_tuple(1, 2) : std::make_tuple(2, 1));
+  const auto spacetime = std::make_shared<Spacetime>();
+  spacetime->seed(1);
+  spacetime->buildSlabs(schedule, slabs);
+  const std::size_t edges = spacetime->getEdgeList()->size();
+  std::printf("%zu vertices, %zu edges\n", spacetime->getVertexList()->size(), edges);
+
+  const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+  for (const double repulsion : {0., 1.}) {
+    for (const std::size_t threads : {std::size_t{1}, hardware}) {
+      EmbeddingOptions options{};
+      options.dimensions = 3;
+      options.maxIterations = static_cast<std::size_t>(iterations);
+      options.tolerance = 0.;
+      options.threads = threads;
+      options.repulsion = repulsion;
+      spacetime->seed(2);
+      const EmbeddingStats stats = spacetime->embed(options);
+      std::printf("repulsion %.0f, %zu threads: %zu iterations in %.3f s, %.3f ms/iteration, %.1fM edges/s, "
+                  "stress %.4g\n", repulsion, threads, stats.iterations, stats.seconds,
+                  1e3 * stats.seconds / static_cast<double>(stats.iterations),
+                  static_cast<double>(edges * stats.iterations) / stats.seconds / 1e6, stats.stress);
+    }
+  }
+
+#if CASET_WITH_TORCH
+  // embedEuclidean stops once its loss changes by less than epsilon; give embed the same tolerance and no cap.
+  constexpr double kTolerance = 1e-6;
+  EmbeddingOptions options{};
+  options.dimensions = 3;
+  options.maxIterations = static_cast<std::size_t>(-1);
+  options.tolerance = kTolerance;
+  spacetime->seed(2);
+  const double native = spacetime->embed(options).seconds;
+  const auto copy = spacetime->clone();
+  bench::Stopwatch stopwatch{};
+  copy->embedEuclidean(3, kTolerance);
+  const double torch = stopwatch.seconds();
+  std::printf("to convergence: native %.3f s, torch %.3f s, %.1fx: %s the 10x target\n", native, torch,
+              torch / native, torch >= 10. * native ? "meets" : "misses");
+#endif
+  return 0;
+}
@@ -0,0 +1,93 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// Reports the memory footprint of the building blocks of a complex: bytes per Edge and bytes per 4-simplex, both for
+// the arity-specialized fingerprints and for the previous layout where every fingerprint carried 64 inline IDs.
+//
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "spacetime/Spacetime.h"
+
+using namespace caset;
+
+namespace {
+/// The fingerprint layout every Edge and Simplex used to carry regardless of arity.
+using LegacyFingerprint = BasicFingerprint<64>;
+
+constexpr std::size_t legacyEdgeSize = sizeof(Edge) - sizeof(EdgeFingerprint) + sizeof(LegacyFingerprint);
+constexpr std::size_t legacySimplexSize = sizeof(Simplex) - sizeof(SimplexFingerprint) + sizeof(LegacyFingerprint);
+}
+
+int main(int argc, char **argv) {
+  const int numEdges = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  const int numSimplices = argc > 2 ? std::atoi(argv[2]) : 100000;
+
+  std::printf("sizeof(EdgeFingerprint)    = %zu\n", sizeof(EdgeFingerprint));
+  std::printf("sizeof(SimplexFingerprint) = %zu\n", sizeof(SimplexFingerprint));
+  std::printf("sizeof(LegacyFingerprint)  = %zu\n\n", sizeof(LegacyFingerprint));
+
+  std::printf("sizeof(Edge)    before = %zu, after = %zu\n", legacyEdgeSize, sizeof(Edge));
+  std::printf("sizeof(Simplex) before = %zu, after = %zu\n\n", legacySimplexSize, sizeof(Simplex));
+
+  // Heap bytes per edge, including the shared_ptr control block and the EdgeList index.
+  std::size_t edgeBytes = 0;
+  {
+    EdgeList edgeList{};
+    bench::AllocationScope scope{};
+    for (int i = 0; i < numEdges; i++) {
+      edgeList.add(static_cast<IdType>(i), static_cast<IdType>(i) + 1, 1.);
+    }
+    edgeBytes = scope.bytesAllocated();
+  }
+  const double perEdge = static_cast<double>(edgeBytes) / numEdges;
+  std::printf("Heap bytes per edge        before = %.1f, after = %.1f\n",
+              perEdge - sizeof(Edge) + legacyEdgeSize,
+              perEdge);
+
+  // Heap bytes per 4-simplex, including its vertices, edges and materialized facets.
+  std::size_t simplexBytes = 0;
+  std::size_t facetsCreated = 0;
+  {
+    Spacetime spacetime{};
+    std::vector<SimplexPtr> simplices{};
+    simplices.reserve(numSimplices);
+    bench::AllocationScope scope{};
+    for (int i = 0; i < numSimplices; i++) {
+      auto simplex = spacetime.createSimplex(std::tuple<uint8_t, uint8_t>{4, 1});
+      facetsCreated += simplex->getFacets().size();
+      simplices.push_back(simplex);
+    }
+    simplexBytes = scope.bytesAllocated();
+  }
+  const double perSimplex = static_cast<double>(simplexBytes) / numSimplices;
+  // Each 4-simplex owns 10 edges and (k + 1) facets, each of which carries a fingerprint of its own.
+  const double facetsPerSimplex = static_cast<double>(facetsCreated) / numSimplices;
+  const double legacyPerSimplex = perSimplex
+                                  + (1. + facetsPerSimplex) * (legacySimplexSize - sizeof(Simplex))
+                                  + 10. * (legacyEdgeSize - sizeof(Edge));
+  std::printf("Heap bytes per 4-simplex   before = %.1f, after = %.1f\n", legacyPerSimplex, perSimplex);
+  return 0;
+}
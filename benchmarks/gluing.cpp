@@ -0,0 +1,108 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// Counts heap allocations and time per gluing step: creating a simplex, choosing the faces to glue and attaching them.
+// The read-only queries on the gluing path (getGluableFaces and facet availability) are measured separately and
+// should not allocate once facets have been materialized.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <tuple>
+
+#include "BenchmarkUtils.h"
+#include "spacetime/Spacetime.h"
+
+using namespace caset;
+
+int main(int argc, char **argv) {
+  const int warmup = argc > 1 ? std::atoi(argv[1]) : 1000;
+  const int steps = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+  Spacetime spacetime{};
+  spacetime.build(warmup);
+
+  const std::tuple<uint8_t, uint8_t> orientations[] = {{1, 2}, {2, 1}};
+  std::size_t createAllocations = 0, chooseAllocations = 0, attachAllocations = 0;
+  double createSeconds = 0, chooseSeconds = 0, attachSeconds = 0;
+  int glued = 0;
+
+  SimplexPtr previous{};
+  SimplexPtr current{};
+  for (int i = 0; i < steps; i++) {
+    SimplexPtr simplex;
+    {
+      bench::AllocationScope scope{};
+      bench::Stopwatch stopwatch{};
+      simplex = spacetime.createSimplex(orientations[i % 2]);
+      createSeconds += stopwatch.seconds();
+      createAllocations += scope.allocations();
+    }
+    OptionalSimplexPair faces;
+    {
+      bench::AllocationScope scope{};
+      bench::Stopwatch stopwatch{};
+      faces = spacetime.chooseSimplexFacesToGlue(simplex);
+      chooseSeconds += stopwatch.seconds();
+      chooseAllocations += scope.allocations();
+    }
+    if (!faces.has_value()) break;
+    {
+      const auto &[leftFace, rightFace] = faces.value();
+      bench::AllocationScope scope{};
+      bench::Stopwatch stopwatch{};
+      const auto [attached, succeeded] = spacetime.causallyAttachFaces(leftFace, rightFace);
+      attachSeconds += stopwatch.seconds();
+      attachAllocations += scope.allocations();
+      if (succeeded) glued++;
+    }
+    previous = current;
+    current = simplex;
+  }
+  if (glued == 0) {
+    std::printf("No simplices were glued.\n");
+    return 1;
+  }
+
+  std::printf("Glued %d of %d simplices onto a complex of %d\n", glued, steps, warmup);
+  std::printf("  create:  %8.1f allocations/step  %8.2f us/step\n",
+              static_cast<double>(createAllocations) / glued, 1e6 * createSeconds / glued);
+  std::printf("  choose:  %8.1f allocations/step  %8.2f us/step\n",
+              static_cast<double>(chooseAllocations) / glued, 1e6 * chooseSeconds / glued);
+  std::printf("  attach:  %8.1f allocations/step  %8.2f us/step\n",
+              static_cast<double>(attachAllocations) / glued, 1e6 * attachSeconds / glued);
+
+  // The read-only queries, repeated against two simplices whose facets already exist.
+  const int queries = 10000;
+  std::size_t queryAllocations = 0;
+  {
+    bench::AllocationScope scope{};
+    for (int i = 0; i < queries; i++) {
+      const auto faces = spacetime.getGluableFaces(previous, current);
+      const bool available = previous->hasCausallyAvailableFacet() && current->hasCausallyAvailableFacet();
+      if (faces.has_value() && !available) std::abort();
+    }
+    queryAllocations = scope.allocations();
+  }
+  std::printf("  query:   %8.3f allocations/call\n", static_cast<double>(queryAllocations) / queries);
+  return 0;
+}
@@ -0,0 +1,67 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// Attempted and accepted moves per second for each CDT move type, on a 2D strip built with Spacetime::buildSlabs.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "simulations/CDT.h"
+#include "spacetime/Spacetime.h"
+
+using namespace caset;
+
+int main(int argc, char **argv) {
+  const int slabs = argc > 1 ? std::atoi(argv[1]) : 16;
+  const int perSlab = argc > 2 ? std::atoi(argv[2]) : 2001;
+  const int sweeps = argc > 3 ? std::atoi(argv[3]) : 10;
+
+  std::vector<std::tuple<uint8_t, uint8_t> > schedule{{2, 1}};
+  for (int i = 0; i < perSlab; i++) schedule.emplace_back(i % 2 == 0 ? std::make_tuple(1, 2) : std::make_tuple(2, 1));
+  const auto spacetime = std::make_shared<Spacetime>();
+  spacetime->seed(1);
+  spacetime->buildSlabs(schedule, slabs, 1);
+
+  CDT cdt(spacetime);
+  cdt.seed(1);
+  const std::size_t volume = static_cast<std::size_t>(slabs) * schedule.size();
+  bench::Stopwatch stopwatch{};
+  std::size_t accepted = 0;
+  for (int i = 0; i < sweeps; i++) accepted += cdt.sweep(volume);
+  const double seconds = stopwatch.seconds();
+  std::printf("%d sweeps of %zu attempts: %.3f s, %zu accepted, %zu vertices after\n", sweeps, volume, seconds,
+              accepted, spacetime->getVertexList()->size());
+
+  const char *names[] = {"add", "remove", "flip", "shift", "ishift"};
+  std::printf("%8s %10s %10s %12s %12s\n", "move", "attempted", "accepted", "attempts/s", "accepts/s");
+  for (std::size_t m = 0; m < CDT::kNumMoves; m++) {
+    const auto &stats = cdt.getStats(static_cast<CDT::Move>(m));
+    std::printf("%8s %10zu %10zu %12.0f %12.0f\n", names[m], stats.attempted, stats.accepted,
+                stats.attemptedPerSecond(), stats.acceptedPerSecond());
+  }
+  return 0;
+}
@@ -0,0 +1,68 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// Wall time of a multi-slice 2D build with Spacetime::buildSlabs as the number of worker threads doubles, against
+// building the same slabs' worth of simplices serially with buildBulk. The merge is serial and reported separately.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "spacetime/Spacetime.h"
+
+using namespace caset;
+
+int main(int argc, char **argv) {
+  const int slabs = argc > 1 ? std::atoi(argv[1]) : 32;
+  const int perSlab = argc > 2 ? std::atoi(argv[2]) : 20001;
+  const unsigned maxThreads = argc > 3 ? std::atoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+  // An odd number of simplices after the seed leaves as many vertices on the upper slice as on the lower one.
+  std::vector<std::tuple<uint8_t, uint8_t> > schedule{{2, 1}};
+  for (int i = 0; i < perSlab; i++) schedule.emplace_back(i % 2 == 0 ? std::make_tuple(1, 2) : std::make_tuple(2, 1));
+
+  {
+    std::vector<std::tuple<uint8_t, uint8_t> > serial{};
+    for (int i = 0; i < slabs; i++) serial.insert(serial.end(), schedule.begin(), schedule.end());
+    Spacetime spacetime{};
+    bench::Stopwatch stopwatch{};
+    spacetime.buildBulk(serial);
+    std::printf("buildBulk, %d simplices: %.3f s\n", slabs * (perSlab + 1), stopwatch.seconds());
+  }
+
+  std::printf("%8s %10s %10s %10s\n", "threads", "wall s", "merge s", "speedup");
+  double baseline = 0;
+  for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+    Spacetime spacetime{};
+    bench::Stopwatch stopwatch{};
+    const BuildStats stats = spacetime.buildSlabs(schedule, slabs, threads);
+    const double seconds = stopwatch.seconds();
+    if (threads == 1) baseline = seconds;
+    std::printf("%8u %10.3f %10.3f %10.2f\n", threads, seconds, stats.mergeSeconds, baseline / seconds);
+  }
+  return 0;
+}
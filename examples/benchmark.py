@@ -54,8 +54,20 @@ stmt_cpp = """
 st.build()
 """
 
+setup_bulk = """
+import numpy as np
+from caset import Spacetime
+st = Spacetime()
+schedule = np.array([(2, 3)] + [[(1, 4), (2, 3)][i % 2] for i in range(100000)], dtype=np.uint8)
+"""
+
+stmt_bulk = """
+stats = st.buildBulk(schedule)
+"""
+
 print("Python: ", timeit.timeit(stmt_python, setup=setup_python, number=1))
 print("C++   : ", timeit.timeit(stmt_cpp, setup=setup_cpp, number=1))
+print("Bulk  : ", timeit.timeit(stmt_bulk, setup=setup_bulk, number=1))
 
 #print("Creating simplices in c++...")
 #
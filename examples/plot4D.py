@@ -59,41 +59,18 @@ def embed_euclidean(st, dimensions=4, epsilon=1e-10):
     lr = 1e-2
     max_iters = 10000  # safety cap
 
-    edgeVector = st.getEdgeList().toVector()
     vertexVector = st.getVertexList().toVector()
 
-    # --- Map vertex IDs to indices and times ---
-    vertexIdToIndex = {}
-    vertexTimes = []
-    for i, vertex in enumerate(vertexVector):
-        vid = vertex.getId()
-        vertexIdToIndex[vid] = i
-        vertexTimes.append(vertex.getTime())
-
-    vertexTimesTensor = torch.tensor(vertexTimes, dtype=torch.double)  # (N,)
-
-    # --- Edge index and length data ---
-    edgeIdxToSourceIndex = [0] * E
-    edgeIdxToTargetIndex = [0] * E
-    edgeIdxToAbsoluteSquaredLength = [0.0] * E
-
-    for e, edge in enumerate(edgeVector):
-        s_id = edge.getSourceId()
-        t_id = edge.getTargetId()
-
-        s_idx = vertexIdToIndex[s_id]
-        t_idx = vertexIdToIndex[t_id]
-
-        edgeIdxToSourceIndex[e] = s_idx
-        edgeIdxToTargetIndex[e] = t_idx
-
-        L = edge.getSquaredLength()
-        # Treat |L| as the "target" squared Euclidean edge length
-        edgeIdxToAbsoluteSquaredLength[e] = abs(L) if abs(L) > 0 else epsilon
+    # --- Vertex times and edge data, one array each rather than one call per object ---
+    # Edge endpoints are vertex rows, in the same order as vertexVector.
+    vertexTimesTensor = torch.from_numpy(st.getTimeArray())  # (N,)
+    edges = torch.from_numpy(st.getEdgeArray())  # (E, 2)
+    edgeIdxToSourceIdxTensor = edges[:, 0].contiguous()
+    edgeIdxToTargetIdxTensor = edges[:, 1].contiguous()
 
-    edgeIdxToSourceIdxTensor = torch.tensor(edgeIdxToSourceIndex, dtype=torch.long)
-    edgeIdxToTargetIdxTensor = torch.tensor(edgeIdxToTargetIndex, dtype=torch.long)
-    targetSqLenTensor = torch.tensor(edgeIdxToAbsoluteSquaredLength, dtype=torch.double)
+    # Treat |L| as the "target" squared Euclidean edge length
+    targetSqLenTensor = torch.from_numpy(st.getSquaredLengthArray()).abs()
+    targetSqLenTensor = torch.where(targetSqLenTensor > 0, targetSqLenTensor, torch.full_like(targetSqLenTensor, epsilon))
 
     # --- Learn ONLY spatial coordinates (time is fixed separately) ---
     # positions[i] is (x_1, ..., x_{d-1}) for vertex i
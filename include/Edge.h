@@ -23,20 +23,15 @@
 #define CASET_CASET_SRC_EDGE_H_
 
 #include "Fingerprint.h"
+#include "Pool.h"
+#include "Random.h"
 
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
-#include <random>
+#include <utility>
 #include <memory>
 
-inline double random_uniform(double min = -1.0, double max = 1.0) {
-  static std::random_device rd;
-  static std::mt19937 gen(rd());
-  std::uniform_real_distribution<double> dist(min, max);
-  return dist(gen);
-}
-
 namespace caset {
 /// # Edge Disposition
 ///
@@ -74,6 +69,7 @@ struct EdgeKeyEqual {
 };
 
 class Simplex;
+class Vertex;
 
 /// # Edge Class
 ///
@@ -86,7 +82,7 @@ class Simplex;
 /// @param squaredLength_ The squared length of the edge according to whatever spacetime metric is being used. We work
 ///   in squared lengths to allow the use of imaginary Edge lengths (they have negative values).
 ///
-class Edge : public std::enable_shared_from_this<Edge> {
+class Edge : public std::enable_shared_from_this<Edge>, public Pooled<Edge> {
   public:
     Edge(
       std::uint64_t sourceId_,
@@ -95,12 +91,14 @@ class Edge : public std::enable_shared_from_this<Edge> {
     ) : sourceId(sourceId_), targetId(targetId_), squaredLength(squaredLength_), fingerprint({sourceId_, targetId_}) {
     }
 
+    /// An Edge with a squared length drawn uniformly from [-1, 1) by `rng`. Edges built only to look others up should
+    /// pass a length instead, so they do no RNG work.
     Edge(
       std::uint64_t sourceId_,
-      std::uint64_t targetId_
-    ) : sourceId(sourceId_), targetId(targetId_), fingerprint({sourceId_, targetId_}) {
-      // Set squaredLength to a random value between -1 and 1
-      squaredLength = random_uniform(); // TODO: Should we use a poisson dist here for coset theory?
+      std::uint64_t targetId_,
+      Philox &rng
+    ) : Edge(sourceId_, targetId_, 2. * rng.uniform() - 1.) {
+      // TODO: Should we use a poisson dist here for coset theory?
     }
 
     [[nodiscard]] std::uint64_t getSourceId() const noexcept {
@@ -135,6 +133,12 @@ class Edge : public std::enable_shared_from_this<Edge> {
       refreshFingerprint();
     }
 
+    /// Swaps the source and target in place. Like `replaceTargetVertex`, the edge must be unregistered first.
+    void reverse() {
+      std::swap(sourceId, targetId);
+      refreshFingerprint();
+    }
+
     ///
     /// @param vertexId The ID of a Vertex for which ownership should be checked.
     /// @return true if the Vertex exists as an endpoint of this edge
@@ -163,25 +167,32 @@ class Edge : public std::enable_shared_from_this<Edge> {
       return fingerprint.fingerprint();
     }
 
-    Fingerprint fingerprint;
+    EdgeFingerprint fingerprint;
 
     std::pair<IdType, IdType> getKey() const noexcept {
       return {sourceId, targetId};
     }
 
-    std::vector<std::shared_ptr<Simplex> > getSimplices() const noexcept { return simplices; }
+    const std::vector<std::shared_ptr<Simplex> > &getSimplices() const noexcept { return simplices; }
 
     void addSimplex(const std::shared_ptr<Simplex> &simplex) noexcept { simplices.push_back(simplex); }
 
   private:
+    friend class Vertex;
+
     std::uint64_t sourceId;
     std::uint64_t targetId;
     std::vector<std::shared_ptr<Simplex> > simplices;
 
+    /// Back-indices into the source Vertex's out-edges and the target Vertex's in-edges, so either Vertex can drop
+    /// this Edge with a swap-remove instead of a search. Maintained by Vertex.
+    std::uint32_t sourceSlot = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t targetSlot = std::numeric_limits<std::uint32_t>::max();
+
     /// We use fingerprints for fast hashing by the equivalence class of sets of vertices. This method updates the
     /// fingerprint for this Edge after replacing a source or target vertex in-place.
     void refreshFingerprint() noexcept {
-      fingerprint = Fingerprint({sourceId, targetId});
+      fingerprint = EdgeFingerprint({sourceId, targetId});
     }
 
     double squaredLength;
@@ -0,0 +1,179 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_EDGEINDEX_H
+#define CASET_EDGEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Edge.h"
+
+namespace caset {
+///
+/// # EdgeIndex
+///
+/// An open-addressing (linear probing) hash table from an undirected vertex pair to the Edge joining them. The key is
+/// the canonical (min, max) pair of vertex IDs stored inline in the slot, so lookups, inserts and erases never
+/// allocate and never touch the Edge itself until a candidate slot is found. Erasure uses backward shifting, so the
+/// table has no tombstones.
+///
+/// Like Edge fingerprints, the key is unordered: a -> b and b -> a map to the same slot.
+///
+class EdgeIndex {
+  public:
+    EdgeIndex() = default;
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /// Ensures `n` edges fit without rehashing.
+    void reserve(std::size_t n) {
+      std::size_t capacity = kMinCapacity;
+      while (n * kMaxLoadDenominator >= capacity * kMaxLoadNumerator) capacity <<= 1;
+      if (capacity > slots.size()) rehash(capacity);
+    }
+
+    ///
+    /// @return The stored Edge between `a` and `b` (in either direction), or nullptr.
+    [[nodiscard]] const EdgePtr *find(IdType a, IdType b) const noexcept {
+      if (size_ == 0) return nullptr;
+      const Key key = Key::of(a, b);
+      for (std::size_t i = home(key);; i = (i + 1) & mask()) {
+        const Slot &slot = slots[i];
+        if (slot.edge == nullptr) return nullptr;
+        if (slot.key == key) return &slot.edge;
+      }
+    }
+
+    ///
+    /// Looks up the Edge between `a` and `b`, inserting `make()` if there is none. The table is probed once either
+    /// way, and `make` is only called on a miss.
+    ///
+    /// @return {edge, inserted}
+    template<typename Make>
+    std::pair<const EdgePtr &, bool> getOrInsert(IdType a, IdType b, Make &&make) {
+      if ((size_ + 1) * kMaxLoadDenominator >= slots.size() * kMaxLoadNumerator) {
+        rehash(slots.empty() ? kMinCapacity : slots.size() * 2);
+      }
+      const Key key = Key::of(a, b);
+      std::size_t i = home(key);
+      for (; slots[i].edge != nullptr; i = (i + 1) & mask()) {
+        if (slots[i].key == key) return {slots[i].edge, false};
+      }
+      EdgePtr edge = make();
+      slots[i].key = key;
+      slots[i].edge = std::move(edge);
+      size_++;
+      return {slots[i].edge, true};
+    }
+
+    ///
+    /// @return Whether an Edge between `a` and `b` was present.
+    bool erase(IdType a, IdType b) noexcept {
+      if (size_ == 0) return false;
+      const Key key = Key::of(a, b);
+      std::size_t i = home(key);
+      for (; slots[i].edge != nullptr; i = (i + 1) & mask()) {
+        if (slots[i].key == key) break;
+      }
+      if (slots[i].edge == nullptr) return false;
+
+      // Backward-shift: pull later entries of the probe run into the hole unless their home lies cyclically
+      // within (hole, j], in which case moving them would put them before their home.
+      std::size_t hole = i;
+      for (std::size_t j = (hole + 1) & mask(); slots[j].edge != nullptr; j = (j + 1) & mask()) {
+        const std::size_t k = home(slots[j].key);
+        const bool stays = hole <= j ? (hole < k && k <= j) : (hole < k || k <= j);
+        if (stays) continue;
+        slots[hole] = std::move(slots[j]);
+        hole = j;
+      }
+      slots[hole].edge = nullptr;
+      size_--;
+      return true;
+    }
+
+    template<typename F>
+    void forEach(F &&f) const {
+      for (const auto &slot : slots) {
+        if (slot.edge != nullptr) f(slot.edge);
+      }
+    }
+
+    void clear() noexcept {
+      slots.clear();
+      size_ = 0;
+    }
+
+  private:
+    struct Key {
+      IdType lo = 0;
+      IdType hi = 0;
+
+      static Key of(IdType a, IdType b) noexcept {
+        return a < b ? Key{a, b} : Key{b, a};
+      }
+
+      bool operator==(const Key &other) const noexcept = default;
+    };
+
+    struct Slot {
+      Key key{};
+      EdgePtr edge{};
+    };
+
+    static constexpr std::size_t kMinCapacity = 16;
+    static constexpr std::size_t kMaxLoadNumerator = 7;
+    static constexpr std::size_t kMaxLoadDenominator = 10;
+
+    std::vector<Slot> slots{};
+    std::size_t size_ = 0;
+
+    [[nodiscard]] std::size_t mask() const noexcept { return slots.size() - 1; }
+
+    [[nodiscard]] std::size_t home(const Key &key) const noexcept {
+      // splitmix64 finalizer over both IDs.
+      std::uint64_t h = key.lo * 0x9e3779b97f4a7c15ULL ^ key.hi;
+      h ^= h >> 30;
+      h *= 0xbf58476d1ce4e5b9ULL;
+      h ^= h >> 27;
+      h *= 0x94d049bb133111ebULL;
+      h ^= h >> 31;
+      return static_cast<std::size_t>(h) & mask();
+    }
+
+    void rehash(std::size_t capacity) {
+      std::vector<Slot> old = std::exchange(slots, std::vector<Slot>(capacity));
+      for (auto &slot : old) {
+        if (slot.edge == nullptr) continue;
+        std::size_t i = home(slot.key);
+        while (slots[i].edge != nullptr) i = (i + 1) & mask();
+        slots[i] = std::move(slot);
+      }
+    }
+};
+} // caset
+
+#endif //CASET_EDGEINDEX_H
@@ -28,99 +28,101 @@
 
 #include <memory>
 #include <vector>
-#include <unordered_set>
 
 #include "Edge.h"
+#include "EdgeIndex.h"
+#include "Pool.h"
 #include "Logger.h"
 
 namespace caset {
 class EdgeList {
   public:
+    EdgeList() = default;
+
+    /// @param pool_ Storage for edges created by this list. Edges added by pointer keep their own storage.
+    explicit EdgeList(std::shared_ptr<Pool<Edge> > pool_) noexcept : pool(std::move(pool_)) {
+    }
+
     std::shared_ptr<Edge> add(const std::shared_ptr<Edge> &edge) {
-      return getOrInsert(edge);
+      return getOrInsert(edge->getSourceId(), edge->getTargetId(), [&] { return edge; });
     }
 
-    std::shared_ptr<Edge> add(std::uint64_t src, std::uint64_t tgt) {
-      auto edge = std::make_shared<Edge>(src, tgt);
-      return getOrInsert(edge);
+    /// An Edge is only constructed, and its length drawn from `rng`, if none exists between `src` and `tgt`.
+    std::shared_ptr<Edge> add(std::uint64_t src, std::uint64_t tgt, Philox &rng) {
+      return getOrInsert(src, tgt, [&] { return makePooled<Edge>(pool.get(), src, tgt, rng); });
     }
 
     std::shared_ptr<Edge> add(std::uint64_t src, std::uint64_t tgt, double squaredLength) noexcept {
-      auto edge = std::make_shared<Edge>(src, tgt, squaredLength);
-      return getOrInsert(edge);
+      return getOrInsert(src, tgt, [&] { return makePooled<Edge>(pool.get(), src, tgt, squaredLength); });
     }
 
     void remove(const EdgeKey &edgeKey) noexcept {
       const auto &[srcId, tgtId] = edgeKey;
-      auto tempEdge = std::make_shared<Edge>(srcId, tgtId);
-      if (edgeList.contains(tempEdge)) {
-        remove(*edgeList.find(tempEdge));
-      // } else {
-        // CLOG(WARN_LEVEL, "-----------------------------------------------");
-        // CLOG(WARN_LEVEL, "Edge: ", tempEdge->toString(), " not found in: ");
-        // for (const auto &e : edgeList) {
-          // CLOG(WARN_LEVEL, "    - ", e->toString());
-        // }
-        // CLOG(WARN_LEVEL, "----------------------------------------------");
-      }
+      edgeIndex.erase(srcId, tgtId);
     }
 
     void remove(const EdgePtr &edge) noexcept {
-      if (!edgeList.contains(edge)) {
-        // CLOG(WARN_LEVEL, "You attempted to remove an edge that does not exist: ", edge->toString());
-        // for (const auto &e : edgeList) {
-          // CLOG(WARN_LEVEL, "    - ", e->toString());
-        // }
-        return;
-      }
-      edgeList.erase(edge);
+      edgeIndex.erase(edge->getSourceId(), edge->getTargetId());
     }
 
     void replace(std::shared_ptr<Edge> &toRemove, std::shared_ptr<Edge> &toAdd) noexcept {
-      edgeList.erase(toRemove);
-      edgeList.insert(toAdd);
+      remove(toRemove);
+      edgeIndex.getOrInsert(toAdd->getSourceId(), toAdd->getTargetId(), [&] { return toAdd; });
     }
 
     [[nodiscard]] std::vector<std::shared_ptr<Edge> > toVector() const noexcept {
       std::vector<std::shared_ptr<Edge>> result;
-      result.reserve(edgeList.size());
-      for (auto &edge : edgeList) {
-        result.push_back(edge);
-      }
+      result.reserve(edgeIndex.size());
+      edgeIndex.forEach([&](const EdgePtr &edge) { result.push_back(edge); });
       return result;
     }
 
+    /// Calls `visit` on each edge in `toVector` order, without copying the pointers.
+    template<typename F>
+    void forEach(F &&visit) const {
+      edgeIndex.forEach(visit);
+    }
+
     [[nodiscard]] std::size_t size() const {
-      return edgeList.size();
+      return edgeIndex.size();
+    }
+
+    void clear() noexcept {
+      edgeIndex.clear();
+    }
+
+    /// Ensures `n` edges fit without rehashing the index.
+    void reserve(std::size_t n) {
+      edgeIndex.reserve(n);
     }
 
     std::shared_ptr<Edge> get(const EdgeKey &edgeKey) const {
       const auto &[srcId, tgtId] = edgeKey;
-      auto tempEdge = std::make_shared<Edge>(srcId, tgtId);
-      if (!edgeList.contains(tempEdge)) {
-        CLOG(WARN_LEVEL, tempEdge->toString(), " not found! Returning nullptr.");
+      const EdgePtr *found = edgeIndex.find(srcId, tgtId);
+      if (found == nullptr) {
+        CLOG(WARN_LEVEL, std::to_string(srcId), "->", std::to_string(tgtId), " not found! Returning nullptr.");
         return nullptr;
       }
-      return *edgeList.find(tempEdge);
+      return *found;
     }
 
   private:
-    std::unordered_set<std::shared_ptr<Edge>, EdgeHash, EdgeEq> edgeList{};
-
-    std::shared_ptr<Edge> getOrInsert(const std::shared_ptr<Edge> &edge) {
-      if (edge->getSourceId() == edge->getTargetId()) {
-        throw std::runtime_error("You cannot create an edge from a vertex to itself: " + edge->toString());
+    std::shared_ptr<Pool<Edge> > pool{};
+    EdgeIndex edgeIndex{};
+
+    template<typename Make>
+    std::shared_ptr<Edge> getOrInsert(std::uint64_t src, std::uint64_t tgt, Make &&make) {
+      if (src == tgt) {
+        throw std::runtime_error(
+          "You cannot create an edge from a vertex to itself: " + std::to_string(src) + "->" + std::to_string(tgt));
       }
-      if (edgeList.contains(edge)) {
-        auto found = *edgeList.find(edge);
-        if (found->getSourceId() != edge->getSourceId() || found->getTargetId() != edge->getTargetId()) {
-          throw std::runtime_error("Fingerprint collision between edges: " + edge->toString() + " and " + found->toString());
-        }
-        return found;
+      const auto &[found, inserted] = edgeIndex.getOrInsert(src, tgt, std::forward<Make>(make));
+      if (!inserted && (found->getSourceId() != src || found->getTargetId() != tgt)) {
+        throw std::runtime_error(
+          "Fingerprint collision between edges: " + std::to_string(src) + "->" + std::to_string(tgt) + " and " +
+          found->toString());
       }
-      // CLOG(DEBUG_LEVEL, "Adding edge: ", edge->toString());
-      edgeList.insert(edge);
-      return edge;
+      return found;
     }
 };
 } // caset
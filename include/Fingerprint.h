@@ -35,19 +35,31 @@
 #include <algorithm>
 #include <memory>
 #include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <span>
+#include <stdexcept>
 
 namespace caset {
 
 using IdType = std::uint64_t;
-inline constexpr std::size_t kMax = 64;
-using IdArray = std::array<IdType, kMax>;
 inline constexpr std::uint64_t kSeed = 0xcbf29ce484222325ull;
 
+///
+/// The maximum number of vertices a Simplex fingerprint can hold. A k-simplex has k + 1 vertices, so this covers up to
+/// 7-simplices, which is well past the 4-simplices we use for 4D CDT.
+inline constexpr std::size_t kMaxSimplexVertices = 8;
+
 ///
 /// ## Fingerprint
 /// Any category of the equivalence class defined by a unique set of (e.g. vertex) IDs can be enforced by the
 /// Fingerprint class.
 ///
+/// The IDs are stored inline, so the fingerprint is templated on the maximum number of IDs it may hold. An Edge only
+/// ever has 2 IDs and a 4-simplex only 5; sizing the inline storage to match keeps the footprint of each Edge and
+/// Simplex small when there are millions of them. Use `EdgeFingerprint` and `SimplexFingerprint` rather than
+/// instantiating `BasicFingerprint` directly.
+///
 /// To implement this, you should include an instance of the Fingerprint class at the `fingerprint` public member of
 /// whatever class you're implementing it on. Then you can also use the Eq and Hash templates like:
 ///
@@ -77,11 +89,26 @@ inline constexpr std::uint64_t kSeed = 0xcbf29ce484222325ull;
 ///
 /// Note that it has to be in the std:: namespace.
 ///
-class Fingerprint {
+template<std::size_t N>
+class BasicFingerprint {
   public:
+    static_assert(N > 0 && N <= std::numeric_limits<std::uint8_t>::max(), "BasicFingerprint: unsupported arity");
+
+    static constexpr std::size_t kArity = N;
+    using IdArray = std::array<IdType, N>;
 
-    explicit Fingerprint(const std::vector<IdType> &ids_) : ids_({})  {
-      refreshFingerprint(ids_);
+    BasicFingerprint() noexcept = default;
+
+    BasicFingerprint(std::initializer_list<IdType> ids__) {
+      refreshFingerprint(std::span<const IdType>(ids__.begin(), ids__.size()));
+    }
+
+    explicit BasicFingerprint(std::span<const IdType> ids__) {
+      refreshFingerprint(ids__);
+    }
+
+    explicit BasicFingerprint(const std::vector<IdType> &ids__) {
+      refreshFingerprint(std::span<const IdType>(ids__));
     }
 
     static inline std::uint64_t mix64(IdType x) noexcept {
@@ -91,18 +118,21 @@ class Fingerprint {
       return x ^ (x >> 31);
     }
 
-    static std::tuple<std::uint64_t, std::uint8_t, IdArray> computeFingerprint(
-      const std::vector<IdType> &ids__) {
-      if (ids__.size() > kMax) throw std::length_error("VertexFingerprint: Too many ids");
+    static std::tuple<std::uint64_t, std::uint8_t, IdArray> computeFingerprint(std::span<const IdType> ids__) {
+      if (ids__.size() > N) throw std::length_error("VertexFingerprint: Too many ids");
       std::uint8_t n = static_cast<std::uint8_t>(ids__.size());
       IdArray ids{};
-      for (std::size_t i = 0; i < n; ++i) {
-        ids[i] = ids__[i];
+      std::copy(ids__.begin(), ids__.end(), ids.begin());
+      // Insertion sort; n is at most a handful of IDs so this beats std::sort.
+      for (std::uint8_t i = 1; i < n; ++i) {
+        IdType x = ids[i];
+        std::uint8_t j = i;
+        for (; j > 0 && ids[j - 1] > x; --j) ids[j] = ids[j - 1];
+        ids[j] = x;
       }
-      std::sort(ids.begin(), ids.begin() + n);
       auto it = std::unique(ids.begin(), ids.begin() + n);
       n = static_cast<std::uint8_t>(std::distance(ids.begin(), it));
-      std::uint64_t h = 0xcbf29ce484222325ull ^ n;
+      std::uint64_t h = kSeed ^ n;
       for (std::uint8_t i = 0; i < n; ++i) {
         h ^= mix64(ids[i] + 0x9e3779b97f4a7c15ull);
         h *= 0x100000001b3ull; // FNV-ish step
@@ -110,7 +140,7 @@ class Fingerprint {
       return {h, n, ids};
     }
 
-    std::string toString() {
+    std::string toString() const {
       std::stringstream ss;
       ss << "<Fingerprint: " << h_ << " (";
       for (std::size_t i = 0; i < n_; ++i) {
@@ -123,23 +153,33 @@ class Fingerprint {
 
     std::uint64_t fingerprint() const noexcept { return h_; }
 
+    /// @return The sorted, de-duplicated IDs this fingerprint was computed from.
+    std::span<const IdType> ids() const noexcept { return {ids_.data(), n_}; }
+
+    void refreshFingerprint(std::span<const IdType> ids__) {
+      std::tie(h_, n_, ids_) = computeFingerprint(ids__);
+    }
+
     void refreshFingerprint(const std::vector<IdType> &ids__) {
-      std::tie(h_, n_, ids_) = Fingerprint::computeFingerprint(ids__);
+      refreshFingerprint(std::span<const IdType>(ids__));
     }
 
-    bool operator==(const Fingerprint &o) const noexcept {
+    bool operator==(const BasicFingerprint &o) const noexcept {
       if (n_ != o.n_) return false;
       if (h_ != o.h_) return false; // fast reject
       return std::memcmp(ids_.data(), o.ids_.data(), n_ * sizeof(IdType)) == 0;
     }
-    bool operator!=(const Fingerprint &o) const noexcept { return !(*this == o); }
+    bool operator!=(const BasicFingerprint &o) const noexcept { return !(*this == o); }
 
   private:
+    std::uint64_t h_{kSeed};
     IdArray ids_{};
     std::uint8_t n_{0};
-    std::uint64_t h_{kSeed};
 };
 
+using EdgeFingerprint = BasicFingerprint<2>;
+using SimplexFingerprint = BasicFingerprint<kMaxSimplexVertices>;
+
 template<typename T>
 struct FingerprintHash {
   using is_transparent = void; // enables heterogeneous lookup
@@ -0,0 +1,126 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_JOB_H
+#define CASET_JOB_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace caset {
+///
+/// Counters that a long call bumps as it goes, and a flag that asks it to stop. Every member is atomic, so other
+/// threads can read the counters and raise the flag at any time.
+///
+/// The calls that accept one (`Spacetime::buildBulk`, `Spacetime::buildSlabs`, `CDT::run`, `EnsembleRunner::run`)
+/// check the flag between simplices or sweeps. A call that stops early leaves its object in a consistent state, with
+/// the work done so far kept.
+struct Progress {
+  /// Simplices glued onto the complex.
+  std::atomic<std::size_t> glued{0};
+  /// Sweeps finished, summed over chains.
+  std::atomic<std::size_t> sweeps{0};
+  /// Move attempts made, summed over chains.
+  std::atomic<std::size_t> attempts{0};
+  std::atomic<std::size_t> accepted{0};
+  std::atomic<bool> cancelled{false};
+
+  [[nodiscard]] bool isCancelled() const noexcept { return cancelled.load(std::memory_order_relaxed); }
+};
+
+///
+/// # Job
+///
+/// Runs a piece of work on its own thread and hands the caller a `Progress` to watch and cancel it through. The
+/// bindings start builds and sampling runs as Jobs, so Python keeps running while they do.
+///
+/// The work's object mustn't be touched from anywhere else until the Job is done, though dropping references to its
+/// records is fine: a Spacetime's pools serialize those frees with the work's allocations. An exception thrown by the
+/// work is kept and rethrown by `get`. Destroying a Job that is still running cancels it and waits for it.
+class Job {
+  public:
+    using Work = std::function<void(Progress &)>;
+
+    ///
+    /// The counters at one moment, with their rates since the Job started.
+    struct Snapshot {
+      std::size_t glued = 0;
+      std::size_t sweeps = 0;
+      std::size_t attempts = 0;
+      std::size_t accepted = 0;
+      double seconds = 0.;
+      double gluedPerSecond = 0.;
+      double sweepsPerSecond = 0.;
+      double attemptsPerSecond = 0.;
+      bool done = false;
+      bool cancelled = false;
+    };
+
+    /// Starts `work` on a new thread.
+    explicit Job(Work work);
+
+    ~Job();
+
+    Job(const Job &) = delete;
+    Job &operator=(const Job &) = delete;
+
+    /// Asks the work to stop at its next check. Returns at once; `wait` for it to actually stop.
+    void cancel() noexcept { progress.cancelled.store(true, std::memory_order_relaxed); }
+
+    ///
+    /// Blocks until the work is done, or for at most `timeout` seconds.
+    /// @return Whether the work is done.
+    bool wait(std::optional<double> timeout = std::nullopt);
+
+    ///
+    /// Waits for the work and rethrows the exception it threw, if any.
+    void get();
+
+    [[nodiscard]] bool isDone() const;
+
+    [[nodiscard]] bool isCancelled() const noexcept { return progress.isCancelled(); }
+
+    [[nodiscard]] Snapshot getProgress() const;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    Progress progress{};
+    const Clock::time_point started = Clock::now();
+    mutable std::mutex mutex{};
+    std::condition_variable finished{};
+    bool done = false;
+    /// When the work finished, so rates stop changing once it has.
+    Clock::time_point stopped{};
+    std::exception_ptr error{};
+    std::thread worker{};
+};
+}
+
+#endif //CASET_JOB_H
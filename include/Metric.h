@@ -86,6 +86,10 @@ class Metric {
       return signature;
     }
 
+    [[nodiscard]] bool isCoordinateFree() const noexcept {
+      return coordinateFree;
+    }
+
   private:
     std::shared_ptr<Signature> signature;
     bool coordinateFree;
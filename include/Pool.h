@@ -0,0 +1,452 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_POOL_H
+#define CASET_POOL_H
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace caset {
+///
+/// # Handle
+///
+/// A generational reference to a record owned by a Pool. The low 32 bits address a slot in the pool, the next 16 hold
+/// the generation of that slot at the time the record was created, and the top 16 the tag of the pool that issued it.
+///
+/// When a slot is freed its generation is bumped, so stale handles resolve to nullptr instead of to whatever reuses the
+/// slot. A slot whose generation would wrap around is retired rather than reused, so a stale handle never matches
+/// again. The tag lets a pool tell its own handles from those of every other live pool (see `PoolTags`).
+///
+class Handle {
+  public:
+    static constexpr std::uint32_t kIndexBits = 32;
+    static constexpr std::uint32_t kGenerationBits = 16;
+    static constexpr std::uint32_t kTagBits = 16;
+    /// The all-ones index is reserved so the invalid handle can never address a live slot.
+    static constexpr std::uint32_t kMaxSlots = std::numeric_limits<std::uint32_t>::max();
+    /// The all-ones tag is reserved too, so the invalid handle belongs to no pool.
+    static constexpr std::uint16_t kNoTag = std::numeric_limits<std::uint16_t>::max();
+    static constexpr std::uint64_t kInvalid = std::numeric_limits<std::uint64_t>::max();
+
+    constexpr Handle() noexcept = default;
+
+    constexpr Handle(std::uint32_t index, std::uint16_t generation, std::uint16_t tag) noexcept
+      : raw_(index | static_cast<std::uint64_t>(generation) << kIndexBits |
+             static_cast<std::uint64_t>(tag) << (kIndexBits + kGenerationBits)) {
+    }
+
+    static constexpr Handle fromRaw(std::uint64_t raw) noexcept {
+      Handle handle;
+      handle.raw_ = raw;
+      return handle;
+    }
+
+    [[nodiscard]] constexpr std::uint32_t index() const noexcept { return static_cast<std::uint32_t>(raw_); }
+    [[nodiscard]] constexpr std::uint16_t generation() const noexcept {
+      return static_cast<std::uint16_t>(raw_ >> kIndexBits);
+    }
+    [[nodiscard]] constexpr std::uint16_t tag() const noexcept {
+      return static_cast<std::uint16_t>(raw_ >> (kIndexBits + kGenerationBits));
+    }
+    [[nodiscard]] constexpr std::uint64_t raw() const noexcept { return raw_; }
+    [[nodiscard]] constexpr bool valid() const noexcept { return raw_ != kInvalid; }
+
+    constexpr bool operator==(const Handle &other) const noexcept = default;
+
+  private:
+    std::uint64_t raw_ = kInvalid;
+};
+
+///
+/// Hands out the tags that mark which Pool issued a Handle. A tag isn't given to another pool while its owner is alive,
+/// and freed tags are reused as late as possible, so a handle from any other live pool never passes for one of this
+/// pool's. Pools are made on worker threads too, so this is thread safe.
+///
+class PoolTags {
+  public:
+    static std::uint16_t acquire() {
+      std::lock_guard lock(mutex);
+      for (std::uint32_t tried = 0; tried < Handle::kNoTag; tried++) {
+        const std::uint16_t tag = next;
+        next = static_cast<std::uint16_t>((next + 1) % Handle::kNoTag);
+        if (!used[tag]) {
+          used[tag] = true;
+          return tag;
+        }
+      }
+      throw std::length_error("Pool: more than " + std::to_string(Handle::kNoTag) + " pools alive");
+    }
+
+    static void release(const std::uint16_t tag) noexcept {
+      if (tag == Handle::kNoTag) return;
+      std::lock_guard lock(mutex);
+      used[tag] = false;
+    }
+
+  private:
+    static inline std::mutex mutex{};
+    static inline std::bitset<Handle::kNoTag> used{};
+    static inline std::uint16_t next = 0;
+};
+
+template<typename T>
+class Pool;
+
+///
+/// Base for records that can live in a Pool. The pool stamps each record with its Handle and a back-pointer to the pool
+/// so that records can allocate siblings (e.g. a Simplex allocating its facets) from the same storage.
+///
+template<typename T>
+class Pooled {
+  public:
+    [[nodiscard]] Handle getHandle() const noexcept { return handle; }
+
+    /// The pool that owns this record, or nullptr if it was allocated on the heap. A pool outlives every record it
+    /// owns, since each record's control block keeps the pool alive through its allocator.
+    [[nodiscard]] Pool<T> *getPool() const noexcept { return pool; }
+
+  private:
+    template<typename>
+    friend class Pool;
+
+    Handle handle{};
+    Pool<T> *pool = nullptr;
+};
+
+///
+/// # Pool
+///
+/// Contiguous, chunked storage for the records of a Spacetime. Blocks are carved out of fixed-size chunks (so addresses
+/// are stable), freed blocks go on a free list for reuse, and every live record is reachable through a Handle.
+///
+/// Records are still handed out as `std::shared_ptr` (through `std::allocate_shared`) so ownership and identity
+/// semantics are unchanged for callers and for the Python bindings; the pool replaces one `malloc` per record, and the
+/// separate control block allocation `std::make_shared` would otherwise scatter across the heap, with a bump into a
+/// chunk. That is also why handles are 64 bits rather than 32: next to an index they carry a generation that takes
+/// long to wrap and the pool's tag, since Python holds records across whole runs and across Spacetimes.
+///
+/// Each Spacetime owns its own pools. Only one thread may create records in a pool at a time, but records can be freed
+/// from any thread: a background Job builds into a Spacetime while Python drops references to its records, so handing
+/// out and taking back blocks, and resolving handles, are serialized by a mutex.
+///
+template<typename T>
+class Pool : public std::enable_shared_from_this<Pool<T> > {
+  public:
+    static_assert(std::is_base_of_v<Pooled<T>, T>, "Pool<T> requires T to derive from Pooled<T>");
+
+    explicit Pool(std::size_t blocksPerChunk_ = 4096)
+      : blocksPerChunk(blocksPerChunk_ == 0 ? 1 : blocksPerChunk_), tag(PoolTags::acquire()) {
+    }
+
+    ~Pool() { PoolTags::release(tag); }
+
+    Pool(const Pool &) = delete;
+    Pool &operator=(const Pool &) = delete;
+
+    template<typename U>
+    class Allocator {
+      public:
+        using value_type = U;
+
+        explicit Allocator(std::shared_ptr<Pool> pool_) noexcept : pool(std::move(pool_)) {
+        }
+
+        template<typename V>
+        Allocator(const Allocator<V> &other) noexcept : pool(other.pool) {
+        }
+
+        template<typename V>
+        struct rebind {
+          using other = Allocator<V>;
+        };
+
+        U *allocate(std::size_t n) {
+          if (pooled(n)) return static_cast<U *>(target()->allocateBlock(sizeof(U)));
+          return static_cast<U *>(::operator new(n * sizeof(U), std::align_val_t{alignof(U)}));
+        }
+
+        void deallocate(U *p, std::size_t n) noexcept {
+          if (pooled(n)) {
+            target()->deallocateBlock(p);
+            return;
+          }
+          ::operator delete(p, std::align_val_t{alignof(U)});
+        }
+
+        template<typename V, typename... Args>
+        void construct(V *p, Args &&... args) {
+          if constexpr (std::is_same_v<V, T>) {
+            const std::uint32_t slot = std::exchange(target()->pendingSlot, kNoSlot);
+            ::new(static_cast<void *>(p)) V(std::forward<Args>(args)...);
+            if (slot != kNoSlot) target()->bind(p, slot);
+          } else {
+            ::new(static_cast<void *>(p)) V(std::forward<Args>(args)...);
+          }
+        }
+
+        template<typename V>
+        void destroy(V *p) noexcept {
+          if constexpr (std::is_same_v<V, T>) target()->unbind(p);
+          p->~V();
+        }
+
+        template<typename V>
+        bool operator==(const Allocator<V> &other) const noexcept { return pool == other.pool; }
+
+      private:
+        template<typename>
+        friend class Allocator;
+
+        std::shared_ptr<Pool> pool;
+
+        /// The pool that now owns `pool`'s blocks; see `Pool::absorb`.
+        Pool *target() const noexcept {
+          Pool *owner = pool.get();
+          while (owner->forward != nullptr) owner = owner->forward.get();
+          return owner;
+        }
+
+        /// Only single-object allocations of the block size the pool settled on go through the pool. The first
+        /// pooled allocation (the shared_ptr control block with the record inline) fixes that size.
+        bool pooled(std::size_t n) const noexcept {
+          if (n != 1 || alignof(U) > kBlockAlignment) return false;
+          const Pool *owner = target();
+          return owner->blockSize == 0 || owner->blockSize == sizeof(U);
+        }
+    };
+
+    ///
+    /// Constructs a record in this pool.
+    ///
+    /// @return A shared_ptr whose control block and record share one pooled block.
+    template<typename... Args>
+    std::shared_ptr<T> create(Args &&... args) {
+      return std::allocate_shared<T>(Allocator<T>(this->shared_from_this()), std::forward<Args>(args)...);
+    }
+
+    ///
+    /// @return The live record addressed by `handle`, or nullptr if the handle is invalid, stale or not this pool's.
+    [[nodiscard]] T *get(const Handle handle) const noexcept {
+      if (!owns(handle)) return nullptr;
+      std::lock_guard lock(mutex);
+      const std::uint32_t slot = handle.index();
+      if (slot >= objects.size() || generations[slot] != handle.generation()) return nullptr;
+      return objects[slot];
+    }
+
+    ///
+    /// @return A new owning reference to the record addressed by `handle`, or nullptr if it is no longer alive.
+    [[nodiscard]] std::shared_ptr<T> lock(const Handle handle) const noexcept {
+      T *record = get(handle);
+      if (record == nullptr) return nullptr;
+      return record->weak_from_this().lock();
+    }
+
+    /// @return Whether this pool issued `handle`, whether or not its record is still alive.
+    [[nodiscard]] bool owns(const Handle handle) const noexcept {
+      return handle.valid() && handle.tag() == tag;
+    }
+
+    /// Ensures at least `n` blocks can be handed out without allocating another chunk.
+    void reserve(std::size_t n) {
+      std::lock_guard lock(mutex);
+      if (blockSize == 0) {
+        reserveHint = std::max(reserveHint, n);
+        return;
+      }
+      while (capacity() < n) addChunk();
+    }
+
+    ///
+    /// Takes over every chunk of `other`, which must have the same block layout, along with its records and free
+    /// blocks. Records keep their addresses and are re-issued handles in this pool; handles from `other` go stale.
+    /// `other` forwards later allocations and frees here, since the records' control blocks still refer to it.
+    ///
+    /// Lets records be built in a private pool (e.g. on another thread) and then handed to a shared one without copying.
+    void absorb(Pool &other) {
+      if (&other == this || other.blockSize == 0) return;
+      std::scoped_lock lock(mutex, other.mutex);
+      if (other.blocksPerChunk != blocksPerChunk || (blockSize != 0 && blockSize != other.blockSize)) {
+        throw std::invalid_argument("Pool: cannot absorb a pool with a different block layout");
+      }
+      // Adopted chunks have to start on a chunk boundary for blockAt() to find them, so the rest of our last chunk
+      // goes on the free list.
+      const std::size_t base = capacity();
+      if (base + other.capacity() > Handle::kMaxSlots) {
+        throw std::length_error("Pool: exhausted " + std::to_string(Handle::kMaxSlots) + " handles");
+      }
+      if (blockSize == 0) {
+        blockSize = other.blockSize;
+        stride = other.stride;
+      }
+      freeSlots.reserve(base + other.capacity());
+      for (auto slot = nextSlot; slot < base; slot++) {
+        generations.push_back(0);
+        objects.push_back(nullptr);
+        freeSlots.push_back(slot);
+      }
+      for (auto &chunk : other.chunks) chunks.push_back(std::move(chunk));
+      for (std::uint32_t slot = 0; slot < other.nextSlot; slot++) {
+        const auto moved = static_cast<std::uint32_t>(base + slot);
+        *reinterpret_cast<std::uint32_t *>(blockAt(moved)) = moved;
+        generations.push_back(other.generations[slot]);
+        objects.push_back(other.objects[slot]);
+        if (T *record = other.objects[slot]) {
+          auto &pooled = static_cast<Pooled<T> &>(*record);
+          pooled.handle = Handle(moved, other.generations[slot], tag);
+          pooled.pool = this;
+        }
+      }
+      for (const auto slot : other.freeSlots) freeSlots.push_back(static_cast<std::uint32_t>(base + slot));
+      nextSlot = static_cast<std::uint32_t>(base + other.nextSlot);
+      live += other.live;
+
+      other.chunks.clear();
+      other.freeSlots.clear();
+      other.generations.clear();
+      other.objects.clear();
+      other.nextSlot = 0;
+      other.live = 0;
+      other.forward = this->shared_from_this();
+      // `other` never issues another handle, so its tag can go to a new pool.
+      PoolTags::release(std::exchange(other.tag, Handle::kNoTag));
+    }
+
+    /// @return The number of live records.
+    [[nodiscard]] std::size_t size() const noexcept { return live; }
+
+    /// @return The number of blocks in allocated chunks.
+    [[nodiscard]] std::size_t capacity() const noexcept { return chunks.size() * blocksPerChunk; }
+
+  private:
+    static constexpr std::uint32_t kNoSlot = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+    /// Each block starts with its slot index so the block can be returned to the free list after the record (and
+    /// possibly long after, once the last weak reference drops) is gone.
+    static constexpr std::size_t kHeaderSize = kBlockAlignment;
+
+    struct ChunkDeleter {
+      void operator()(std::byte *p) const noexcept { ::operator delete(p, std::align_val_t{kBlockAlignment}); }
+    };
+
+    std::size_t blocksPerChunk;
+    std::size_t blockSize = 0;
+    std::size_t stride = 0;
+    std::size_t reserveHint = 0;
+    std::size_t live = 0;
+    std::uint32_t pendingSlot = kNoSlot;
+    std::uint32_t nextSlot = 0;
+    std::uint16_t tag;
+    /// Set once this pool has been absorbed into another.
+    std::shared_ptr<Pool> forward{};
+    mutable std::mutex mutex{};
+
+    std::vector<std::unique_ptr<std::byte, ChunkDeleter> > chunks{};
+    std::vector<std::uint32_t> freeSlots{};
+    std::vector<std::uint16_t> generations{};
+    std::vector<T *> objects{};
+
+    void addChunk() {
+      auto *chunk = static_cast<std::byte *>(
+        ::operator new(stride * blocksPerChunk, std::align_val_t{kBlockAlignment}));
+      chunks.emplace_back(chunk);
+    }
+
+    std::byte *blockAt(const std::uint32_t slot) const noexcept {
+      return chunks[slot / blocksPerChunk].get() + (slot % blocksPerChunk) * stride;
+    }
+
+    void *allocateBlock(const std::size_t size) {
+      std::lock_guard lock(mutex);
+      if (blockSize == 0) {
+        blockSize = size;
+        stride = (kHeaderSize + size + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+        while (capacity() < reserveHint) addChunk();
+      }
+      std::uint32_t slot;
+      if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+      } else {
+        if (nextSlot >= Handle::kMaxSlots) {
+          throw std::length_error("Pool: exhausted " + std::to_string(Handle::kMaxSlots) + " handles");
+        }
+        slot = nextSlot++;
+        if (slot >= capacity()) addChunk();
+        generations.push_back(0);
+        objects.push_back(nullptr);
+        // Every slot fits on the free list at once, so `deallocateBlock` never has to grow it.
+        if (freeSlots.capacity() < objects.size()) freeSlots.reserve(std::max(objects.size(), 2 * freeSlots.capacity()));
+      }
+      std::byte *block = blockAt(slot);
+      *reinterpret_cast<std::uint32_t *>(block) = slot;
+      pendingSlot = slot;
+      return block + kHeaderSize;
+    }
+
+    void deallocateBlock(void *p) noexcept {
+      const std::byte *block = static_cast<std::byte *>(p) - kHeaderSize;
+      const std::uint32_t slot = *reinterpret_cast<const std::uint32_t *>(block);
+      std::lock_guard lock(mutex);
+      // A slot whose generation wraps is retired, since a handle from its first generation would address it again.
+      if (++generations[slot] != 0) freeSlots.push_back(slot);
+    }
+
+    void bind(T *record, const std::uint32_t slot) noexcept {
+      auto &pooled = static_cast<Pooled<T> &>(*record);
+      std::lock_guard lock(mutex);
+      pooled.handle = Handle(slot, generations[slot], tag);
+      pooled.pool = this;
+      objects[slot] = record;
+      live++;
+    }
+
+    void unbind(T *record) noexcept {
+      auto &pooled = static_cast<Pooled<T> &>(*record);
+      if (pooled.pool != this) return;
+      std::lock_guard lock(mutex);
+      objects[pooled.handle.index()] = nullptr;
+      live--;
+    }
+};
+
+///
+/// Allocates a record in `pool` when one is given, or on the heap otherwise.
+template<typename T, typename... Args>
+std::shared_ptr<T> makePooled(Pool<T> *pool, Args &&... args) {
+  if (pool != nullptr) return pool->create(std::forward<Args>(args)...);
+  return std::make_shared<T>(std::forward<Args>(args)...);
+}
+} // caset
+
+#endif //CASET_POOL_H
@@ -0,0 +1,214 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_RANDOM_H
+#define CASET_RANDOM_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <tuple>
+#include <utility>
+
+namespace caset {
+///
+/// # Philox
+///
+/// The Philox4x32-10 counter-based generator from "Parallel Random Numbers: As Easy as 1, 2, 3" by J. K. Salmon, M. A.
+/// Moraes, R. O. Dror and D. E. Shaw, SC 2011. Every output is a pure function of a 64-bit key (the seed), a 64-bit
+/// stream and a 64-bit position, so a generator is just those three numbers:
+///
+/// - Streams split one seed into independent sequences without any coordination. Give each chain, replica or thread
+///   its own stream and the results depend only on the seed, never on scheduling.
+/// - Skipping ahead is free, and `fillUniform` computes blocks in a loop the compiler vectorizes.
+/// - Unlike the `<random>` distributions, `uniform`, `below`, `normal` and `exponential` are specified here, so a seed
+///   reproduces a run bit for bit across standard libraries.
+///
+/// It satisfies UniformRandomBitGenerator, so it works with the `<random>` distributions too. Each block yields two
+/// 64-bit words; the batch fills consume the same words as the scalar calls, in the same order.
+class Philox {
+  public:
+    using result_type = std::uint64_t;
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    Philox() noexcept : Philox(0) {
+    }
+
+    explicit Philox(const std::uint64_t seed_, const std::uint64_t stream_ = 0) noexcept {
+      seed(seed_, stream_);
+    }
+
+    /// Restarts the generator at the beginning of `stream_` under `seed_`.
+    void seed(const std::uint64_t seed_, const std::uint64_t stream_ = 0) noexcept {
+      key = {low(seed_), high(seed_)};
+      stream = stream_;
+      words = 0;
+    }
+
+    /// @return A generator at the beginning of another stream under the same seed.
+    [[nodiscard]] Philox split(const std::uint64_t stream_) const noexcept {
+      return Philox(getSeed(), stream_);
+    }
+
+    [[nodiscard]] std::uint64_t getSeed() const noexcept {
+      return join(key[0], key[1]);
+    }
+
+    [[nodiscard]] std::uint64_t getStream() const noexcept {
+      return stream;
+    }
+
+    /// @return The number of 64-bit words drawn so far.
+    [[nodiscard]] std::uint64_t getPosition() const noexcept {
+      return words;
+    }
+
+    static constexpr result_type min() noexcept {
+      return 0;
+    }
+
+    static constexpr result_type max() noexcept {
+      return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() noexcept {
+      if ((words & 1) == 0) spare = draw(words / 2);
+      return spare[words++ & 1];
+    }
+
+    void discard(const unsigned long long n) noexcept {
+      words += n;
+      if ((words & 1) != 0) spare = draw(words / 2);
+    }
+
+    /// @return A uniform double in [0, 1) with 53 random bits.
+    double uniform() noexcept {
+      return toUnit((*this)());
+    }
+
+    /// @return An exponential variate with the given rate, by inversion.
+    double exponential(const double rate = 1.) noexcept {
+      return -std::log(1. - uniform()) / rate;
+    }
+
+    ///
+    /// @return A uniform integer in [0, n), or 0 when n is 0. Lemire's multiply-shift maps a word onto the range and
+    ///   rejects the few words that would bias it, so unlike `std::uniform_int_distribution` the draws are specified.
+    /// @see "Fast Random Integer Generation in an Interval", D. Lemire, 2019.
+    std::uint64_t below(const std::uint64_t n) noexcept {
+      if (n == 0) return 0;
+      auto [hi, lo] = multiply((*this)(), n);
+      if (lo < n) {
+        const std::uint64_t threshold = (0 - n) % n;
+        while (lo < threshold) std::tie(hi, lo) = multiply((*this)(), n);
+      }
+      return hi;
+    }
+
+    /// @return A standard normal variate from two `uniform` draws, by the Box-Muller transform. Only the cosine
+    ///   branch is used, so every call draws exactly two words.
+    double normal() noexcept {
+      const double radius = std::sqrt(-2. * std::log(1. - uniform()));
+      return radius * std::cos(2. * std::numbers::pi * uniform());
+    }
+
+    /// Fills `out` with what the same number of `uniform` calls would return.
+    void fillUniform(std::span<double> out) noexcept;
+
+    /// Fills `out` with what the same number of `exponential` calls would return.
+    void fillExponential(std::span<double> out, double rate = 1.) noexcept;
+
+    /// Ten rounds of Philox4x32 on one counter.
+    static constexpr Counter block(Counter counter, Key roundKey) noexcept {
+      for (int round = 0; round < 10; round++) {
+        const std::uint64_t product0 = static_cast<std::uint64_t>(kMultiplier0) * counter[0];
+        const std::uint64_t product1 = static_cast<std::uint64_t>(kMultiplier1) * counter[2];
+        counter = {
+          high(product1) ^ counter[1] ^ roundKey[0], low(product1),
+          high(product0) ^ counter[3] ^ roundKey[1], low(product0)
+        };
+        roundKey[0] += kWeyl0;
+        roundKey[1] += kWeyl1;
+      }
+      return counter;
+    }
+
+    static constexpr double toUnit(const std::uint64_t word) noexcept {
+      return static_cast<double>(word >> 11) * 0x1p-53;
+    }
+
+    bool operator==(const Philox &other) const noexcept {
+      return key == other.key && stream == other.stream && words == other.words;
+    }
+
+  private:
+    static constexpr std::uint32_t kMultiplier0 = 0xD2511F53u;
+    static constexpr std::uint32_t kMultiplier1 = 0xCD9E8D57u;
+    static constexpr std::uint32_t kWeyl0 = 0x9E3779B9u;
+    static constexpr std::uint32_t kWeyl1 = 0xBB67AE85u;
+
+    Key key{};
+    std::uint64_t stream = 0;
+    std::uint64_t words = 0;
+    std::array<std::uint64_t, 2> spare{};
+
+    static constexpr std::uint32_t low(const std::uint64_t value) noexcept {
+      return static_cast<std::uint32_t>(value);
+    }
+
+    static constexpr std::uint32_t high(const std::uint64_t value) noexcept {
+      return static_cast<std::uint32_t>(value >> 32);
+    }
+
+    static constexpr std::uint64_t join(const std::uint32_t lo, const std::uint32_t hi) noexcept {
+      return static_cast<std::uint64_t>(hi) << 32 | lo;
+    }
+
+    /// @return The high and low words of the 128-bit product `a` * `b`.
+    static constexpr std::pair<std::uint64_t, std::uint64_t> multiply(const std::uint64_t a,
+                                                                      const std::uint64_t b) noexcept {
+      const std::uint64_t lowLow = static_cast<std::uint64_t>(low(a)) * low(b);
+      const std::uint64_t highLow = static_cast<std::uint64_t>(high(a)) * low(b);
+      const std::uint64_t lowHigh = static_cast<std::uint64_t>(low(a)) * high(b);
+      const std::uint64_t highHigh = static_cast<std::uint64_t>(high(a)) * high(b);
+      const std::uint64_t middle = (lowLow >> 32) + low(highLow) + low(lowHigh);
+      return {highHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32), (middle << 32) | low(lowLow)};
+    }
+
+    /// @return The two words of block `index` in this stream.
+    [[nodiscard]] std::array<std::uint64_t, 2> draw(const std::uint64_t index) const noexcept {
+      const Counter out = block({low(index), high(index), low(stream), high(stream)}, key);
+      return {join(out[0], out[1]), join(out[2], out[3])};
+    }
+
+    /// Writes the words of `count` consecutive blocks starting at block `first` into `out`.
+    void drawBlocks(std::uint64_t first, std::size_t count, std::uint64_t *__restrict out) const noexcept;
+};
+
+/// The generator used throughout caset.
+using Rng = Philox;
+} // caset
+
+#endif // CASET_RANDOM_H
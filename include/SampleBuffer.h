@@ -0,0 +1,119 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_SAMPLEBUFFER_H
+#define CASET_SAMPLEBUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace caset {
+///
+/// # SampleBuffer
+///
+/// Append-only rows of `width` doubles with one writer and any number of concurrent readers, and no locks. Rows are
+/// written into fixed-size chunks that never move. A row is published by a release store of its chunk's row count,
+/// and a chunk by a release store of the link to it, so a reader walking the chunks with acquire loads sees only
+/// complete rows.
+///
+/// `EnsembleRunner` gives each worker thread one of these, so measuring never contends and merging can happen while
+/// the workers are still appending.
+class SampleBuffer {
+  public:
+    explicit SampleBuffer(const std::size_t width_, const std::size_t rowsPerChunk_ = 4096)
+      : width(width_), rowsPerChunk(std::max<std::size_t>(rowsPerChunk_, 1)) {
+      chunks.push_back(std::make_unique<Chunk>(width * rowsPerChunk));
+      head = chunks.front().get();
+    }
+
+    SampleBuffer(const SampleBuffer &) = delete;
+    SampleBuffer &operator=(const SampleBuffer &) = delete;
+
+    /// Appends a row. Only one thread may append at a time.
+    void append(std::span<const double> row) {
+      Chunk *tail = chunks.back().get();
+      std::size_t rows = tail->rows.load(std::memory_order_relaxed);
+      if (rows == rowsPerChunk) {
+        chunks.push_back(std::make_unique<Chunk>(width * rowsPerChunk));
+        tail->next.store(chunks.back().get(), std::memory_order_release);
+        tail = chunks.back().get();
+        rows = 0;
+      }
+      std::copy_n(row.begin(), std::min(row.size(), width), tail->data.get() + rows * width);
+      tail->rows.store(rows + 1, std::memory_order_release);
+    }
+
+    /// Calls `visit` with each row published so far, in the order they were appended. Safe alongside `append`.
+    template<typename Visit>
+    void forEach(Visit &&visit) const {
+      for (const Chunk *chunk = head; chunk != nullptr;) {
+        // The link is read before the row count: a chunk is only linked once it's full, so a reader that sees the
+        // link also sees every row in the chunk, and never skips rows appended between the two loads.
+        const Chunk *next = chunk->next.load(std::memory_order_acquire);
+        const std::size_t rows = chunk->rows.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < rows; i++) visit(std::span<const double>(chunk->data.get() + i * width, width));
+        chunk = next;
+      }
+    }
+
+    /// @return The number of rows published so far. Safe alongside `append`.
+    [[nodiscard]] std::size_t size() const {
+      std::size_t rows = 0;
+      for (const Chunk *chunk = head; chunk != nullptr;) {
+        const Chunk *next = chunk->next.load(std::memory_order_acquire);
+        rows += chunk->rows.load(std::memory_order_acquire);
+        chunk = next;
+      }
+      return rows;
+    }
+
+    [[nodiscard]] std::size_t getWidth() const noexcept { return width; }
+
+    /// Drops every row. Not safe alongside `append` or the readers.
+    void clear() {
+      chunks.resize(1);
+      head->rows.store(0, std::memory_order_relaxed);
+      head->next.store(nullptr, std::memory_order_relaxed);
+    }
+
+  private:
+    struct Chunk {
+      explicit Chunk(const std::size_t capacity) : data(std::make_unique<double[]>(capacity)) {
+      }
+
+      std::unique_ptr<double[]> data;
+      std::atomic<std::size_t> rows{0};
+      std::atomic<Chunk *> next{nullptr};
+    };
+
+    std::size_t width;
+    std::size_t rowsPerChunk;
+    /// Owned by the writer. Readers start at `head` and follow `Chunk::next` instead, so this can grow while they read.
+    std::vector<std::unique_ptr<Chunk> > chunks{};
+    Chunk *head = nullptr;
+};
+}
+
+#endif //CASET_SAMPLEBUFFER_H
@@ -0,0 +1,101 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_SAMPLINGINDEX_H
+#define CASET_SAMPLINGINDEX_H
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Random.h"
+
+namespace caset {
+///
+/// # SamplingIndex
+///
+/// A set that supports O(1) insert, erase and uniform random selection. Items are kept in a dense vector with a map
+/// from item to position; erasing moves the last item into the hole.
+///
+/// Iteration order is arbitrary and changes as items are erased.
+///
+template<typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<T> >
+class SamplingIndex {
+  public:
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    /// @return Whether `item` was newly inserted.
+    bool insert(const T &item) {
+      const auto [position, inserted] = positions.try_emplace(item, items.size());
+      if (inserted) items.push_back(item);
+      return inserted;
+    }
+
+    /// @return Whether `item` was present.
+    bool erase(const T &item) {
+      const auto position = positions.find(item);
+      if (position == positions.end()) return false;
+      const std::size_t i = position->second;
+      positions.erase(position);
+      if (i + 1 != items.size()) {
+        items[i] = std::move(items.back());
+        positions[items[i]] = i;
+      }
+      items.pop_back();
+      return true;
+    }
+
+    [[nodiscard]] bool contains(const T &item) const {
+      return positions.contains(item);
+    }
+
+    ///
+    /// Picks an item uniformly at random. The index must not be empty.
+    [[nodiscard]] const T &sample(Philox &rng) const {
+      return items[rng.below(items.size())];
+    }
+
+    [[nodiscard]] const T &operator[](std::size_t i) const noexcept { return items[i]; }
+    [[nodiscard]] std::size_t size() const noexcept { return items.size(); }
+    [[nodiscard]] bool empty() const noexcept { return items.empty(); }
+
+    const_iterator begin() const noexcept { return items.begin(); }
+    const_iterator end() const noexcept { return items.end(); }
+
+    void reserve(std::size_t n) {
+      items.reserve(n);
+      positions.reserve(n);
+    }
+
+    void clear() noexcept {
+      items.clear();
+      positions.clear();
+    }
+
+  private:
+    std::vector<T> items{};
+    std::unordered_map<T, std::size_t, Hash, Eq> positions{};
+};
+} // caset
+
+#endif //CASET_SAMPLINGINDEX_H
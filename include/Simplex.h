@@ -23,6 +23,7 @@
 #define CASET_SIMPLEX_H
 
 #include <memory>
+#include <optional>
 #include <vector>
 #include <functional>
 #include <algorithm>
@@ -34,6 +35,7 @@
 #include "EdgeList.h"
 #include "VertexList.h"
 #include "Fingerprint.h"
+#include "Pool.h"
 #include "Vertex.h"
 
 namespace caset {
@@ -229,13 +231,13 @@ namespace caset {
 /// Each simplex has a volume \f$ V_s \f$, which can represent various physical properties depending on the context.
 ///
 ///
-class Simplex : public std::enable_shared_from_this<Simplex> {
+class Simplex : public std::enable_shared_from_this<Simplex>, public Pooled<Simplex> {
   public:
     ///
     /// @param vertices_
     explicit Simplex(const Vertices &vertices_, Edges edges_);
 
-    Simplex(const Vertices &vertices_, Edges edges_ ,const SimplexOrientationPtr &orientation_);
+    Simplex(Vertices vertices_, Edges edges_, const SimplexOrientationPtr &orientation_);
 
     void initialize(const std::shared_ptr<Simplex> &simplex);
 
@@ -285,8 +287,9 @@ class Simplex : public std::enable_shared_from_this<Simplex> {
     [[nodiscard]] SimplexOrientationPtr getOrientation() const noexcept;
 
     ///
-    /// @return A list of Vertex (es) in traversal order. You can iterate these to walk the Face.
-    [[nodiscard]] Vertices getVertices() const noexcept;
+    /// @return A list of Vertex (es) in traversal order. You can iterate these to walk the Face. The reference is
+    ///   invalidated when a Vertex of this Simplex is replaced.
+    [[nodiscard]] const Vertices &getVertices() const noexcept;
 
     [[nodiscard]] std::size_t size() const noexcept;
 
@@ -328,11 +331,11 @@ class Simplex : public std::enable_shared_from_this<Simplex> {
     /// to form a simplicial complex \f$ K \f$.
     ///
     /// @return /// all k-1 simplices contained within this k-simplex.
-    [[nodiscard]] std::vector<std::shared_ptr<Simplex> > getFacets();
+    [[nodiscard]] const std::vector<std::shared_ptr<Simplex> > &getFacets();
 
     std::size_t getNumberOfEdges() const;
 
-    Fingerprint fingerprint;
+    SimplexFingerprint fingerprint;
 
     ///
     /// The co-face of a k-simplex \f$ \sigma_i^k \f$ is another k-simplex, \f$ \sigma_j^k \f$ that shares a k-1 simplex
@@ -346,7 +349,7 @@ class Simplex : public std::enable_shared_from_this<Simplex> {
 
 
     /// @returns Edges in traversal order (the order of input vertices).
-    [[nodiscard]] Edges getEdges() const;
+    [[nodiscard]] const Edges &getEdges() const noexcept;
 
     [[nodiscard]]
     std::optional<Vertices>
@@ -395,7 +398,7 @@ class Simplex : public std::enable_shared_from_this<Simplex> {
     /// \f]
     ///
     /// @return The set of k-simplices that share this face.
-    [[nodiscard]] std::unordered_set<std::shared_ptr<Simplex>, SimplexHash, SimplexEq> getCofaces() const noexcept;
+    [[nodiscard]] const std::unordered_set<std::shared_ptr<Simplex>, SimplexHash, SimplexEq> &getCofaces() const noexcept;
 
     bool operator==(const Simplex &other) const noexcept;
 
@@ -414,8 +417,33 @@ class Simplex : public std::enable_shared_from_this<Simplex> {
 
     bool isInternal() const noexcept;
 
-    static std::shared_ptr<Simplex> create(const Vertices &vertices_, const Edges &edges_);
-    static std::shared_ptr<Simplex> create(const Vertices &vertices_, const Edges &edges_, const SimplexOrientationPtr &orientation_);
+    /// Bit `i` is set while `getFacets()[i]` is free to glue.
+    using FacetMask = std::uint8_t;
+    static_assert(kMaxSimplexVertices <= 8, "FacetMask needs a bit per facet");
+
+    ///
+    /// Which facets are still free, as tracked by `Spacetime::causallyAttachFaces`. Unlike
+    /// `hasCausallyAvailableFacet` this doesn't materialize or inspect the facets.
+    [[nodiscard]] FacetMask getFreeFacets() const noexcept {
+      return vertices.size() > 1 ? freeFacets & static_cast<FacetMask>((1u << vertices.size()) - 1) : 0;
+    }
+
+    [[nodiscard]] bool isFacetFree(std::size_t i) const noexcept { return getFreeFacets() >> i & 1u; }
+
+    void markFacetGlued(std::size_t i) noexcept { freeFacets &= static_cast<FacetMask>(~(1u << i)); }
+
+    /// @return The position of the facet with the same fingerprint as `face` in `getFacets()`, if there is one.
+    [[nodiscard]] std::optional<std::size_t> findFacet(const std::shared_ptr<Simplex> &face);
+
+    ///
+    /// @param pool Storage for the new Simplex. Facets are allocated from the same pool as their parent. When nullptr
+    ///   the Simplex is allocated on the heap.
+    static std::shared_ptr<Simplex> create(const Vertices &vertices_, const Edges &edges_, Pool<Simplex> *pool = nullptr);
+    static std::shared_ptr<Simplex> create(
+      const Vertices &vertices_,
+      const Edges &edges_,
+      const SimplexOrientationPtr &orientation_,
+      Pool<Simplex> *pool = nullptr);
 
     /// This method computes the maximum number of k+1 co-faces that can be joined to this k-Simplex _in general_.
     /// Do not use this method the purpose of causal gluing in CDT. It would create internal/non-manifold simplices and
@@ -443,11 +471,14 @@ class Simplex : public std::enable_shared_from_this<Simplex> {
 
     bool operator==(const std::shared_ptr<Simplex> &other) const noexcept;
 
-    VertexIdMap getVertexIdLookup() const noexcept;
+    const VertexIdMap &getVertexIdLookup() const noexcept;
 
     void attach(const VertexPtr &unattached, const VertexPtr &attached, const std::shared_ptr<EdgeList> &edgeList, const std::shared_ptr<VertexList> &vertexList);
 
   private:
+    /// Rewrites vertex IDs in `Spacetime::compact()`.
+    friend class Spacetime;
+
     SimplexOrientationPtr orientation{};
     VertexIdMap vertexIdLookup{};
     Vertices vertices{};
@@ -455,12 +486,19 @@ class Simplex : public std::enable_shared_from_this<Simplex> {
 
     std::vector<std::shared_ptr<Simplex> > facets{};
     std::unordered_set<std::shared_ptr<Simplex>, SimplexHash, SimplexEq> cofaces{};
+    FacetMask freeFacets = static_cast<FacetMask>(~0u);
 
     /// This method replaces the vertex only, Edge (s) should be replaced by the Spacetime, because it maintains the
     /// global lookup for Edge (s). If the Edge source/target is replaced; it's not enough to update the Edge, since
     /// squaredLength data could be lost.
     bool replaceVertex(const VertexPtr &oldVertex, const VertexPtr &newVertex);
 
+    /// Rebuilds the ID lookup and fingerprint after this Simplex's vertices have been renumbered in place.
+    void refreshVertexIds();
+
+    /// Re-buckets the co-faces after their fingerprints have changed.
+    void rehashCofaces();
+
     template<typename Method, typename... Args>
     bool cascade(Method method, bool up, bool down, Args &&... args);
 };
@@ -0,0 +1,179 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_SMALLVECTOR_H
+#define CASET_SMALLVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace caset {
+///
+/// # SmallVector
+///
+/// A vector that keeps its first `N` elements inline and only spills to the heap once it outgrows them. Adjacency
+/// lists in a triangulation are short (tens of entries at most), so most of them never allocate.
+///
+/// The interface is the subset of `std::vector` this library uses, plus `swapRemove` for O(1) unordered erasure.
+///
+template<typename T, std::size_t N>
+class SmallVector {
+  public:
+    static_assert(N > 0, "SmallVector needs at least one inline element");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(const SmallVector &other) {
+      reserve(other.size());
+      for (const auto &value : other) push_back(value);
+    }
+
+    SmallVector(SmallVector &&other) noexcept {
+      takeFrom(std::move(other));
+    }
+
+    SmallVector &operator=(const SmallVector &other) {
+      if (this == &other) return *this;
+      clear();
+      reserve(other.size());
+      for (const auto &value : other) push_back(value);
+      return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept {
+      if (this == &other) return *this;
+      clear();
+      release();
+      takeFrom(std::move(other));
+      return *this;
+    }
+
+    ~SmallVector() {
+      clear();
+      release();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] bool isInline() const noexcept { return data_ == inlineData(); }
+
+    [[nodiscard]] T *data() noexcept { return data_; }
+    [[nodiscard]] const T *data() const noexcept { return data_; }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    T &operator[](std::size_t i) noexcept { return data_[i]; }
+    const T &operator[](std::size_t i) const noexcept { return data_[i]; }
+
+    T &back() noexcept { return data_[size_ - 1]; }
+    const T &back() const noexcept { return data_[size_ - 1]; }
+
+    operator std::span<const T>() const noexcept { return {data_, size_}; }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    T &emplace_back(Args &&... args) {
+      if (size_ == capacity_) {
+        // Construct first, so arguments that alias an element survive the reallocation.
+        T value(std::forward<Args>(args)...);
+        grow(capacity_ * 2);
+        return *::new(static_cast<void *>(data_ + size_++)) T(std::move(value));
+      }
+      return *::new(static_cast<void *>(data_ + size_++)) T(std::forward<Args>(args)...);
+    }
+
+    void pop_back() noexcept {
+      std::destroy_at(data_ + --size_);
+    }
+
+    ///
+    /// Removes the element at `i` by moving the last element into its place. Element order is not preserved.
+    void swapRemove(std::size_t i) noexcept {
+      if (i + 1 != size_) data_[i] = std::move(data_[size_ - 1]);
+      pop_back();
+    }
+
+    void clear() noexcept {
+      std::destroy(data_, data_ + size_);
+      size_ = 0;
+    }
+
+    void reserve(std::size_t n) {
+      if (n > capacity_) grow(n);
+    }
+
+  private:
+    T *data_ = inlineData();
+    std::uint32_t size_ = 0;
+    std::uint32_t capacity_ = N;
+    alignas(T) std::byte inline_[N * sizeof(T)];
+
+    T *inlineData() noexcept { return reinterpret_cast<T *>(inline_); }
+    const T *inlineData() const noexcept { return reinterpret_cast<const T *>(inline_); }
+
+    void grow(std::size_t n) {
+      if (n > std::numeric_limits<std::uint32_t>::max()) throw std::length_error("SmallVector: too many elements");
+      T *grown = std::allocator<T>{}.allocate(n);
+      std::uninitialized_move(data_, data_ + size_, grown);
+      std::destroy(data_, data_ + size_);
+      release();
+      data_ = grown;
+      capacity_ = static_cast<std::uint32_t>(n);
+    }
+
+    /// Frees heap storage (elements must already be destroyed) and points back at the inline buffer.
+    void release() noexcept {
+      if (!isInline()) std::allocator<T>{}.deallocate(data_, capacity_);
+      data_ = inlineData();
+      capacity_ = N;
+    }
+
+    void takeFrom(SmallVector &&other) noexcept {
+      if (other.isInline()) {
+        std::uninitialized_move(other.data_, other.data_ + other.size_, data_);
+        size_ = other.size_;
+        other.clear();
+        return;
+      }
+      data_ = std::exchange(other.data_, other.inlineData());
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, static_cast<std::uint32_t>(N));
+    }
+};
+} // caset
+
+#endif //CASET_SMALLVECTOR_H
@@ -0,0 +1,62 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_VARINT_H
+#define CASET_VARINT_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace caset {
+///
+/// # Varints
+///
+/// Unsigned LEB128: seven bits per byte, least significant group first, with the high bit set on every byte but the
+/// last. Values below 128 take one byte and no 64-bit value takes more than ten, so sorted IDs stored as gaps from
+/// their predecessor shrink to a byte or two each.
+
+/// Appends `value` to `out`.
+inline void encodeVarint(std::vector<std::uint8_t> &out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+///
+/// Reads a value and advances `in` past it.
+///
+/// @throws std::runtime_error If the value runs past `end` or past ten bytes.
+inline std::uint64_t decodeVarint(const std::uint8_t *&in, const std::uint8_t *const end) {
+  std::uint64_t value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (in == end) throw std::runtime_error("varint runs past the end of its buffer");
+    const std::uint8_t byte = *in++;
+    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if (byte < 0x80) return value;
+  }
+  throw std::runtime_error("varint is longer than ten bytes");
+}
+}
+
+#endif //CASET_VARINT_H
@@ -32,6 +32,8 @@
 #include <unordered_map>
 #include "Logger.h"
 #include "Edge.h"
+#include "Pool.h"
+#include "SmallVector.h"
 
 
 namespace caset {
@@ -48,8 +50,16 @@ class Simplex;
 /// Quantum chromodynamics have different and paradoxical coupling parameters at different energy scales. The leading
 /// theories about it are called "running coupling"
 ///
-class Vertex : public std::enable_shared_from_this<Vertex> {
+class Vertex : public std::enable_shared_from_this<Vertex>, public Pooled<Vertex> {
     public:
+        /// Most vertices in a triangulation have a handful of in- and out-edges each, so that many are kept inline.
+        static constexpr std::size_t kInlineEdges = 6;
+
+        ///
+        /// In- or out-edges of a Vertex. Each Edge remembers its index here (see Edge::sourceSlot/targetSlot), so
+        /// removal is a swap with the last entry. Order is not meaningful.
+        using Adjacency = SmallVector<std::shared_ptr<Edge>, kInlineEdges>;
+
         Vertex() noexcept { id = 0; }
         Vertex(const std::uint64_t id_, const std::vector<double> &coords) noexcept : id(id_), coordinates(coords) {
         }
@@ -75,32 +85,38 @@ class Vertex : public std::enable_shared_from_this<Vertex> {
 
         std::vector<double> getCoordinates() const;
 
+        /// @return The coordinates without copying them, empty for a coordinate-independent vertex.
+        [[nodiscard]] const std::vector<double> &getCoordinatesOrEmpty() const noexcept { return coordinates; }
+
         void setCoordinates(const std::vector<double> &coords) noexcept;
 
         [[nodiscard]] std::pair<std::shared_ptr<Edge>, std::shared_ptr<Vertex> > moveTo(
             const std::shared_ptr<Vertex> &vertex);
 
-        void addInEdge(const std::shared_ptr<Edge> &edge) noexcept { inEdges.insert(edge); }
-        void addOutEdge(const std::shared_ptr<Edge> &edge) noexcept { outEdges.insert(edge); }
+        /// Adding an Edge that's already present is a no-op. Callers must pass the one Edge the EdgeList keeps for each
+        /// key; debug builds throw if an equal but distinct Edge is already stored.
+        void addInEdge(const std::shared_ptr<Edge> &edge) { insertEdge(inEdges, edge, &Edge::targetSlot); }
+        void addOutEdge(const std::shared_ptr<Edge> &edge) { insertEdge(outEdges, edge, &Edge::sourceSlot); }
         void removeInEdge(const std::shared_ptr<Edge> &edge) noexcept {
-            if (!inEdges.contains(edge)) CLOG(WARN_LEVEL, "Edge ", edge->toString(), " not found in vertex ", toString());
-            inEdges.erase(edge);
+            if (!eraseEdge(inEdges, edge, &Edge::targetSlot)) {
+                CLOG(WARN_LEVEL, "Edge ", edge->toString(), " not found in vertex ", toString());
+            }
         }
         void removeOutEdge(const std::shared_ptr<Edge> &edge) noexcept {
-            if (!outEdges.contains(edge)) CLOG(WARN_LEVEL, "Edge ", edge->toString(), " not found in vertex ", toString());
-            outEdges.erase(edge);
+            if (!eraseEdge(outEdges, edge, &Edge::sourceSlot)) {
+                CLOG(WARN_LEVEL, "Edge ", edge->toString(), " not found in vertex ", toString());
+            }
         }
 
         std::size_t degree() const noexcept { return inEdges.size() + outEdges.size(); }
 
-        std::unordered_set<std::shared_ptr<Edge>, EdgeHash, EdgeEq>
-        getInEdges() const noexcept { return inEdges; }
+        const Adjacency &getInEdges() const noexcept { return inEdges; }
 
-        std::unordered_set<std::shared_ptr<Edge>, EdgeHash, EdgeEq>
-        getOutEdges() const noexcept { return outEdges; }
+        const Adjacency &getOutEdges() const noexcept { return outEdges; }
 
-        std::unordered_set<std::shared_ptr<Edge>, EdgeHash, EdgeEq>
-        getEdges() const noexcept;
+        /// @return A copy of the in-edges followed by the out-edges. Internal code should walk `getInEdges()` and
+        ///   `getOutEdges()` instead.
+        std::vector<std::shared_ptr<Edge>> getEdges() const noexcept;
 
         std::shared_ptr<Edge>
         getEdge(const EdgeKey &key);
@@ -128,17 +144,23 @@ class Vertex : public std::enable_shared_from_this<Vertex> {
 
         std::string toString() const noexcept;
 
-        std::vector<std::shared_ptr<Simplex>> getSimplices() const noexcept;
+        const std::vector<std::shared_ptr<Simplex>> &getSimplices() const noexcept;
 
         void addSimplex(const std::shared_ptr<Simplex> &simplex);
         void removeSimplex(const std::shared_ptr<Simplex> &simplex);
 
     private:
-        std::unordered_set<std::shared_ptr<Edge>, EdgeHash, EdgeEq> outEdges{};
-        std::unordered_set<std::shared_ptr<Edge>, EdgeHash, EdgeEq> inEdges{};
+        /// Renumbers vertices in `VertexList::compact()`.
+        friend class VertexList;
+
+        Adjacency outEdges{};
+        Adjacency inEdges{};
         std::vector<std::shared_ptr<Simplex>> simplices{};
         std::uint64_t id;
         std::vector<double> coordinates{};
+
+        static bool insertEdge(Adjacency &adjacency, const std::shared_ptr<Edge> &edge, std::uint32_t Edge::*slot);
+        static bool eraseEdge(Adjacency &adjacency, const std::shared_ptr<Edge> &edge, std::uint32_t Edge::*slot) noexcept;
 };
 
 using VertexPtr = std::shared_ptr<Vertex>;
@@ -27,45 +27,66 @@
 #define CASET_VERTEXLIST_H
 
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
-#include <unordered_map>
+#include <limits>
 
+#include "Pool.h"
+#include "Random.h"
 #include "Vertex.h"
 
 namespace caset {
+///
+/// # VertexList
+///
+/// Vertices indexed directly by ID. IDs handed out by the Spacetime are dense, so a vertex lives at `vertices[id]` and
+/// a removed vertex leaves a tombstone (nullptr) behind until `compact()` renumbers the survivors.
+///
+/// A list can start at a `firstId` other than zero, so that a Spacetime built in pieces can give each piece its own ID
+/// range without every piece paying for the IDs below it.
+///
 class VertexList {
   public:
-    std::shared_ptr<Vertex> operator[](const std::uint64_t vertexId) {
-      return vertexList[vertexId];
+    /// Marks IDs in the mapping returned by `compact()` that had no live vertex.
+    static constexpr IdType kRemoved = std::numeric_limits<IdType>::max();
+
+    VertexList() = default;
+
+    /// @param pool_ Storage for vertices created by this list. Vertices added by pointer keep their own storage.
+    explicit VertexList(std::shared_ptr<Pool<Vertex> > pool_, IdType firstId_ = 0) noexcept
+      : pool(std::move(pool_)), firstId(firstId_) {
+    }
+
+    std::shared_ptr<Vertex> operator[](const std::uint64_t vertexId) const noexcept {
+      return get(vertexId);
     }
 
-    std::shared_ptr<Vertex> get(std::uint64_t id) {
-      return vertexList[id];
+    /// @return The vertex with this ID, or nullptr if there is none. Never inserts.
+    std::shared_ptr<Vertex> get(std::uint64_t id) const noexcept {
+      if (id - firstId >= vertices.size()) return nullptr;
+      return vertices[id - firstId];
     }
 
     std::shared_ptr<Vertex> add(const std::shared_ptr<Vertex> &vertex) noexcept {
-      vertexList.insert_or_assign(vertex->getId(), vertex);
+      slot(vertex->getId()) = vertex;
       return vertex;
     }
 
     bool contains(const std::uint64_t id) const noexcept {
-      return vertexList.contains(id);
+      return id - firstId < vertices.size() && vertices[id - firstId] != nullptr;
     }
 
     std::shared_ptr<Vertex> add(const std::uint64_t id, const std::vector<double> &coords) noexcept {
-      if (vertexList.contains(id)) {
-        return vertexList.at(id);
-      }
-      std::shared_ptr<Vertex> vertex = std::make_shared<Vertex>(id, coords);
-      vertexList.insert_or_assign(id, vertex);
-      return vertex;
+      auto &existing = slot(id);
+      if (existing == nullptr) existing = makePooled<Vertex>(pool.get(), id, coords);
+      return existing;
     }
 
     std::shared_ptr<Vertex> add(const std::uint64_t id) noexcept {
-      if (vertexList.contains(id)) return vertexList.at(id);
-      std::shared_ptr<Vertex> vertex = std::make_shared<Vertex>(id);
-      vertexList.insert_or_assign(id, vertex);
-      return vertex;
+      auto &existing = slot(id);
+      if (existing == nullptr) existing = makePooled<Vertex>(pool.get(), id);
+      return existing;
     }
 
     void replace(const std::shared_ptr<Vertex> &toRemove, const std::shared_ptr<Vertex> &toAdd) {
@@ -78,24 +99,101 @@ class VertexList {
       add(toAdd);
     }
 
+    /// Leaves a tombstone at the vertex's ID.
     void remove(const std::shared_ptr<Vertex> &vertex) noexcept {
-      vertexList.erase(vertex->getId());
+      const IdType i = vertex->getId() - firstId;
+      if (i >= vertices.size() || vertices[i] == nullptr) return;
+      vertices[i] = nullptr;
+      live--;
+    }
+
+    /// @return The number of live vertices.
+    std::size_t size() const noexcept {
+      return live;
+    }
+
+    /// @return One past the largest ID ever stored, i.e. the length of a dense array indexed by vertex ID.
+    [[nodiscard]] std::size_t idBound() const noexcept {
+      return firstId + vertices.size();
+    }
+
+    /// @return The smallest ID this list can store.
+    [[nodiscard]] IdType getFirstId() const noexcept {
+      return firstId;
+    }
+
+    /// @return The number of IDs below `idBound()` with no live vertex.
+    [[nodiscard]] std::size_t tombstones() const noexcept {
+      return vertices.size() - live;
+    }
+
+    /// Ensures IDs below `n` can be stored without reallocating.
+    void reserve(std::size_t n) {
+      if (n > firstId) vertices.reserve(n - firstId);
     }
 
-    std::size_t size() noexcept {
-      return vertexList.size();
+    /// Extends the ID range to `bound` with tombstones, as though vertices up to it had been added and removed.
+    void extendTo(std::size_t bound) {
+      if (bound > idBound()) vertices.resize(bound - firstId);
     }
 
+    /// @return Live vertices in ID order.
     std::vector<std::shared_ptr<Vertex>> toVector() const noexcept {
       std::vector<std::shared_ptr<Vertex>> result{};
-      result.reserve(vertexList.size());
-      for (const auto &[key, vertex] : vertexList) {
-        result.push_back(vertex);
+      result.reserve(live);
+      for (const auto &vertex : vertices) {
+        if (vertex != nullptr) result.push_back(vertex);
       }
       return result;
     }
+
+    /// Calls `visit` on each live vertex in ID order, without copying the pointers.
+    template<typename F>
+    void forEach(F &&visit) const {
+      for (const auto &vertex : vertices) {
+        if (vertex != nullptr) visit(vertex);
+      }
+    }
+
+    ///
+    /// @return A live vertex drawn uniformly at random, or nullptr if there are none. Draws are over the ID range, so
+    ///   they slow down as tombstones pile up; `compact()` clears them.
+    std::shared_ptr<Vertex> sample(Philox &rng) const {
+      if (live == 0) return nullptr;
+      while (true) {
+        if (const auto &vertex = vertices[rng.below(vertices.size())]; vertex != nullptr) return vertex;
+      }
+    }
+
+    /// Renumbers the live vertices 0..size()-1, preserving their relative order, and drops the tombstones. Only the
+    /// vertices themselves are renumbered; anything keyed by vertex ID (edges, simplices) must be rewritten by the
+    /// caller. See `Spacetime::compact()`.
+    ///
+    /// @return A mapping from old ID to new ID, with `kRemoved` for IDs that had no live vertex.
+    std::vector<IdType> compact();
+
+    /// @return The mapping `compact()` would return, without renumbering anything, so a caller can check it first.
+    [[nodiscard]] std::vector<IdType> compactMapping() const;
+
+    ///
+    /// Moves every vertex of `other` into this list under its existing ID, leaving `other` empty. The two lists must
+    /// not share any IDs.
+    void absorb(VertexList &other);
+
   private:
-    std::unordered_map<std::uint64_t, std::shared_ptr<Vertex>> vertexList{};
+    std::shared_ptr<Pool<Vertex> > pool{};
+    IdType firstId = 0;
+    /// Indexed by ID - firstId.
+    std::vector<std::shared_ptr<Vertex>> vertices{};
+    std::size_t live = 0;
+
+    std::shared_ptr<Vertex> &slot(const IdType id) {
+      if (id < firstId) throw std::out_of_range("Vertex ID " + std::to_string(id) + " is below this list's first ID");
+      const IdType i = id - firstId;
+      if (i >= vertices.size()) vertices.resize(i + 1);
+      if (vertices[i] == nullptr) live++;
+      return vertices[i];
+    }
 };
 } // caset
 
@@ -32,10 +32,15 @@ namespace caset {
 
 class Spacetime;
 
+///
+/// A scalar measured on a Spacetime. `EnsembleRunner` measures one instance on many chains at once from different
+/// threads, so implementations must not keep per-chain state.
 class Observable {
   public:
-    virtual double compute(std::shared_ptr<Spacetime> &spacetime);
-    virtual double update(std::shared_ptr<Spacetime> &spacetime);
+    /// Measures the Spacetime from scratch.
+    virtual double compute(std::shared_ptr<Spacetime> &spacetime) = 0;
+    /// Measures the Spacetime after a move, using whatever it keeps up to date.
+    virtual double update(std::shared_ptr<Spacetime> &spacetime) = 0;
     virtual ~Observable() = default;
 };
 }
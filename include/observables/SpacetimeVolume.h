@@ -31,6 +31,8 @@
 
 namespace caset {
 class Spacetime;
+///
+/// \f$ N_d \f$, the number of top-dimensional simplices, which CDT takes as the volume of the Spacetime.
 class SpacetimeVolume : public Observable {
   public:
     double compute(std::shared_ptr<Spacetime> &spacetime) override;
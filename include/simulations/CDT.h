@@ -26,28 +26,136 @@
 #ifndef CASET_CDT_H
 #define CASET_CDT_H
 
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+
 #include "simulations/Simulation.h"
+#include "spacetime/Spacetime.h"
 
 namespace caset {
+///
+/// # CDT
+///
+/// Monte Carlo moves for causal dynamical triangulations. Each move draws its site uniformly from the Spacetime's
+/// candidate sites for it (see `Spacetime::countMoveSites`) and asks the Spacetime for the corresponding local rewrite
+/// (see `Spacetime::insertVertex` and the flips next to it). Together they form the ergodic move set of Ambjorn,
+/// Jurkiewicz and Loll:
+///
+/// | Method            | 2D            | 3D                  |
+/// |-------------------|---------------|---------------------|
+/// | `add` / `remove`  | (2, 4)/(4, 2) | (2, 6)/(6, 2)       |
+/// | `flip`            | -             | (4, 4)              |
+/// | `shift` / `ishift`| (2, 2)/-      | (2, 3)/(3, 2)       |
+///
+/// A 2D complex has no faces strictly between a vertex and a facet, so there `flip` and `ishift` have no sites and
+/// `sweep` doesn't attempt them. The (2, 2) move is its own inverse.
+///
+/// Until couplings are set every move is accepted when it's geometrically legal. With couplings, a legal move is also
+/// put to a Metropolis test against the action at those couplings (see `setCouplings`). Each move type keeps count of
+/// how often it was attempted and accepted and of the time spent on it.
 class CDT : public Simulation {
   public:
+    using Move = MoveType;
 
-    void add() {
+    static constexpr std::size_t kNumMoves = kNumMoveTypes;
 
-    }
+    struct MoveStats {
+      std::size_t attempted = 0;
+      std::size_t accepted = 0;
+      /// Time spent attempting moves of this type, accepted or not.
+      double seconds = 0.;
 
-    void flip() {
+      [[nodiscard]] double attemptedPerSecond() const noexcept { return seconds > 0. ? attempted / seconds : 0.; }
+      [[nodiscard]] double acceptedPerSecond() const noexcept { return seconds > 0. ? accepted / seconds : 0.; }
+    };
 
+    ///
+    /// The bare couplings of `Spacetime::action`.
+    struct Couplings {
+      double kappa0 = 0.;
+      double delta = 0.;
+      double kappa4 = 0.;
+    };
+
+    explicit CDT(std::shared_ptr<Spacetime> spacetime_) : spacetime(std::move(spacetime_)) {
     }
 
-    void shift() {
+    /// Splits a random interior spatial face with a new vertex.
+    bool add() { return attempt(Move::Add); }
 
-    }
+    /// Removes a random vertex with the star `add` leaves behind.
+    bool remove() { return attempt(Move::Remove); }
+
+    /// Flips the star of a random spatial face below the slice's dimension (3D and up).
+    bool flip() { return attempt(Move::Flip); }
+
+    /// Flips the star of a random timelike facet.
+    bool shift() { return attempt(Move::Shift); }
+
+    /// Flips the star of a random timelike face smaller than a facet (3D and up).
+    bool ishift() { return attempt(Move::Ishift); }
+
+    /// Attempts one move of the given type, recording it in the stats.
+    /// @return Whether the move was made.
+    bool attempt(Move move);
+
+    /// Attempts `attempts` moves with types drawn uniformly from those that exist in the Spacetime's dimension.
+    /// @return The number of moves made.
+    std::size_t sweep(std::size_t attempts);
+
+    ///
+    /// Makes `sweeps` sweeps of `attempts` move attempts.
+    ///
+    /// @param progress If given, counts each sweep with its attempts and accepted moves, and stops the run before the
+    ///   next sweep once cancelled.
+    /// @return The number of moves made.
+    std::size_t run(std::size_t sweeps, std::size_t attempts, Progress *progress = nullptr);
+
+    ///
+    /// The probability that one step of `sweep` proposes a particular site for `move`: one over the number of move
+    /// types it draws from, times one over the number of candidate sites for `move`. This is the proposal probability
+    /// a Metropolis test weighs against that of the inverse move.
+    ///
+    /// @return The probability, or 0 if `sweep` would never propose `move`.
+    [[nodiscard]] double proposalProbability(Move move);
 
-    void ishift() {
+    ///
+    /// Samples the Spacetime with weight \f$ e^{-S} \f$ at `value` from now on. A move proposed at a site is accepted
+    /// with probability
+    ///
+    /// \f[
+    /// \min\left(1, \frac{n(\text{move})}{n(\text{inverse})} e^{-\Delta S}\right)
+    /// \f]
+    ///
+    /// where n(move) counts the candidate sites of the move type before the move and n(inverse) those of the inverse
+    /// after it. Both the inverse's count and \f$ \Delta S \f$ come from `Spacetime::countChange`, so a rejected move
+    /// is never made. Changing the couplings is O(1), which is what replica exchange relies on.
+    void setCouplings(const Couplings &value) noexcept { couplings = value; }
 
+    [[nodiscard]] const std::optional<Couplings> &getCouplings() const noexcept { return couplings; }
+
+    /// @return The ratio `setCouplings` accepts `move` at its candidate site `site` with, without making it; 1 without
+    ///   couplings.
+    [[nodiscard]] double acceptanceRatio(Move move, const Vertices &site);
+
+    /// @return The action of the Spacetime at `at`.
+    [[nodiscard]] double action(const Couplings &at) const noexcept {
+      return spacetime->action(at.kappa0, at.delta, at.kappa4);
     }
 
+    [[nodiscard]] const MoveStats &getStats(Move move) const noexcept { return stats[static_cast<std::size_t>(move)]; }
+
+    void resetStats() noexcept { stats = {}; }
+
+    /// Seeds the generator used to pick moves and sites, at the start of `stream` under `value`.
+    void seed(std::uint64_t value, std::uint64_t stream = 0) { rng.seed(value, stream); }
+
+    [[nodiscard]] std::shared_ptr<Spacetime> getSpacetime() const noexcept { return spacetime; }
+
     ///
     /// `tune` is the initial stage of building the spacetime. Some example are:
     ///
@@ -71,6 +179,22 @@ class CDT : public Simulation {
     void thermalize() override {
 
     }
+
+  private:
+    std::shared_ptr<Spacetime> spacetime;
+    Rng rng{std::random_device{}()};
+    std::array<MoveStats, kNumMoves> stats{};
+    std::optional<Couplings> couplings{};
+
+    /// @return The move types that have sites in the Spacetime's dimension.
+    [[nodiscard]] std::span<const Move> availableMoves() const noexcept;
+
+    /// Draws a site for `move` and makes the move there if it passes the Metropolis test.
+    /// @return Whether the move was made.
+    bool propose(Move move);
+
+    /// @return Whether to make `move` at `site`. See `setCouplings`.
+    bool metropolis(Move move, const Vertices &site);
 };
 }
 
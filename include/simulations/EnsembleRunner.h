@@ -0,0 +1,122 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_ENSEMBLERUNNER_H
+#define CASET_ENSEMBLERUNNER_H
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "SampleBuffer.h"
+#include "observables/Observable.h"
+#include "simulations/CDT.h"
+#include "spacetime/ConfigurationLog.h"
+
+namespace caset {
+///
+/// # EnsembleRunner
+///
+/// Runs many independent CDT chains at the same couplings on a fixed set of worker threads, and collects the
+/// observables measured along the way.
+///
+/// Chain i always runs on worker i mod T, and on Linux worker t is pinned to CPU t mod the hardware thread count, so
+/// a chain's complex stays in one core's caches for the whole run. Chain i draws from stream i of the runner's seed
+/// (see `Philox`), so a chain's trajectory doesn't depend on how many workers there are.
+///
+/// Every `measureEvery` sweeps a chain appends a row to its worker's `SampleBuffer`: the chain index, the number of
+/// sweeps the chain has made, then the value of each observable. The buffers have a single writer each and need no
+/// locks. `getSamples` and `summarize` merge them on demand, and are safe to call while a run is in progress.
+class EnsembleRunner {
+  public:
+    ///
+    /// The mean and variance of each observable over every row recorded so far.
+    struct Summary {
+      std::size_t samples = 0;
+      std::vector<double> mean{};
+      std::vector<double> variance{};
+    };
+
+    ///
+    /// @param spacetimes The chains' Spacetimes, which must be distinct. `Spacetime::clone` forks them from one state.
+    /// @param threads The number of workers, at most one per chain. 0 uses one per hardware thread.
+    /// @param pin Whether to pin each worker to a CPU.
+    explicit EnsembleRunner(const std::vector<std::shared_ptr<Spacetime> > &spacetimes, std::size_t threads = 0,
+                            bool pin = true);
+
+    /// Puts every chain to the Metropolis test at `couplings` (see `CDT::setCouplings`).
+    void setCouplings(const CDT::Couplings &couplings);
+
+    /// Adds an observable to measure. Observables can only be added before the first row is recorded.
+    void addObservable(const std::shared_ptr<Observable> &observable);
+
+    ///
+    /// Appends each chain's configuration to `log` every `every` sweeps (never when 0), tagged with the chain and the
+    /// sweeps it has made. The log encodes and writes on its own thread; a chain only pays for copying vertex IDs.
+    void setConfigurationLog(std::shared_ptr<ConfigurationLog> log, std::size_t every);
+
+    /// Seeds chain i with stream i of `value`.
+    void seed(std::uint64_t value);
+
+    ///
+    /// Makes `sweeps` sweeps of `attempts` move attempts on every chain, measuring every `measureEvery` sweeps (never
+    /// when 0). Blocks until every chain is done.
+    ///
+    /// @param progress If given, counts each chain's sweeps, attempts and accepted moves. Once it's cancelled, every
+    ///   chain stops before its next sweep, so chains may end the run having made different numbers of sweeps.
+    void run(std::size_t sweeps, std::size_t attempts, std::size_t measureEvery = 1, Progress *progress = nullptr);
+
+    /// @return Every row recorded so far, one after another, ordered by chain and then by sweep.
+    [[nodiscard]] std::vector<double> getSamples() const;
+
+    [[nodiscard]] Summary summarize() const;
+
+    /// Drops the rows recorded so far. Not safe during a run.
+    void clearSamples();
+
+    /// @return The number of doubles in each row: the chain, the sweep and one per observable.
+    [[nodiscard]] std::size_t getSampleWidth() const noexcept { return 2 + observables.size(); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return chains.size(); }
+
+    [[nodiscard]] std::size_t getThreads() const noexcept { return buffers.size(); }
+
+    [[nodiscard]] std::shared_ptr<CDT> getChain(std::size_t chain) const { return chains.at(chain); }
+
+  private:
+    std::vector<std::shared_ptr<CDT> > chains{};
+    /// The sweeps each chain has made over every run.
+    std::vector<std::size_t> sweepsDone{};
+    std::vector<std::shared_ptr<Observable> > observables{};
+    std::shared_ptr<ConfigurationLog> log{};
+    std::size_t logEvery = 0;
+    /// One per worker, written only by that worker.
+    std::vector<std::unique_ptr<SampleBuffer> > buffers{};
+    bool pin;
+
+    /// Runs worker `worker`'s chains.
+    void work(std::size_t worker, std::size_t sweeps, std::size_t attempts, std::size_t measureEvery,
+              Progress *progress);
+};
+}
+
+#endif //CASET_ENSEMBLERUNNER_H
@@ -0,0 +1,136 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_PARALLELTEMPERING_H
+#define CASET_PARALLELTEMPERING_H
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "simulations/CDT.h"
+
+namespace caset {
+///
+/// # ParallelTempering
+///
+/// Replica exchange over a ladder of CDT couplings, for scans that cross a phase boundary. Replica r starts on rung r
+/// of the ladder. Each round runs a sweep on every replica, spread over worker threads, then proposes swaps between
+/// neighbouring rungs. A swap between replicas a and b is accepted with probability
+///
+/// \f[
+/// \min\left(1, e^{S_a(c_a) + S_b(c_b) - S_a(c_b) - S_b(c_a)}\right)
+/// \f]
+///
+/// where \f$ S_a(c) \f$ is the action of replica a's Spacetime at couplings c. A swap exchanges the couplings the two
+/// replicas sample at rather than their triangulations, so it's O(1) whatever their size.
+///
+/// Rounds alternate between swapping the even pairs of rungs (0 and 1, 2 and 3, ...) and the odd ones. That moves
+/// replicas along the ladder in runs instead of a random walk, which shortens round trips.
+///
+/// @see "Exchange Monte Carlo Method and Application to Spin Glass Simulations", K. Hukushima, K. Nemoto, 1996.
+/// @see "Non-Reversible Parallel Tempering: a Scalable Highly Parallel MCMC Scheme", S. Syed et al., 2019.
+class ParallelTempering {
+  public:
+    struct SwapStats {
+      std::size_t attempted = 0;
+      std::size_t accepted = 0;
+
+      [[nodiscard]] double acceptance() const noexcept {
+        return attempted > 0 ? static_cast<double>(accepted) / static_cast<double>(attempted) : 0.;
+      }
+    };
+
+    ///
+    /// A round trip is a replica's walk from the bottom rung to the top one and back. Well-tuned ladders have short,
+    /// frequent round trips; a rung pair with low swap acceptance shows up as long ones.
+    struct RoundTripStats {
+      std::size_t completed = 0;
+      /// The mean length of the completed round trips, in rounds.
+      double meanRounds = 0.;
+    };
+
+    ///
+    /// @param replicas The Spacetimes to sample, one per rung. Each is owned by this driver's replicas from now on and
+    ///   must not be shared between them.
+    /// @param ladder The couplings of each rung, ordered so that neighbours are close.
+    ParallelTempering(const std::vector<std::shared_ptr<Spacetime> > &replicas, std::vector<CDT::Couplings> ladder);
+
+    ///
+    /// Runs `rounds` rounds of `attempts` CDT move attempts on every replica, each followed by an exchange. The sweeps
+    /// run on `threads` worker threads (one per hardware thread when 0), one replica at a time per thread.
+    /// @return The number of swaps accepted.
+    std::size_t run(std::size_t rounds, std::size_t attempts, std::size_t threads = 0);
+
+    ///
+    /// Proposes a swap between every other pair of neighbouring rungs, alternating between the even and odd pairs.
+    /// @return The number of swaps accepted.
+    std::size_t exchange();
+
+    /// Seeds the exchange generator with stream 0 of `value`, and replica i with stream i + 1.
+    void seed(std::uint64_t value);
+
+    [[nodiscard]] std::size_t size() const noexcept { return replicas.size(); }
+
+    [[nodiscard]] const std::vector<CDT::Couplings> &getLadder() const noexcept { return ladder; }
+
+    /// @return The replica currently sampling at rung `rung`.
+    [[nodiscard]] std::shared_ptr<CDT> getReplicaAt(std::size_t rung) const { return replicas[replicaAt.at(rung)]; }
+
+    /// @return The rung replica `replica` is on.
+    [[nodiscard]] std::size_t getRung(std::size_t replica) const { return rungOf.at(replica); }
+
+    /// @return The swaps proposed between rung `rung` and rung `rung` + 1.
+    [[nodiscard]] const SwapStats &getSwapStats(std::size_t rung) const { return swaps.at(rung); }
+
+    [[nodiscard]] RoundTripStats getRoundTripStats() const noexcept;
+
+    /// @return The number of exchanges so far.
+    [[nodiscard]] std::size_t getRounds() const noexcept { return rounds; }
+
+  private:
+    /// Where a replica is headed, by the last end of the ladder it visited.
+    enum class Heading : std::uint8_t {
+      Unknown = 0,
+      Up = 1,
+      Down = 2
+    };
+
+    std::vector<std::shared_ptr<CDT> > replicas{};
+    std::vector<CDT::Couplings> ladder{};
+    std::vector<std::size_t> replicaAt{};
+    std::vector<std::size_t> rungOf{};
+    std::vector<SwapStats> swaps{};
+    std::vector<Heading> headings{};
+    /// The round each replica's current round trip started, when it reached the bottom rung from the top.
+    std::vector<std::size_t> departures{};
+    std::size_t roundTrips = 0;
+    std::size_t roundTripRounds = 0;
+    std::size_t rounds = 0;
+    Rng rng{std::random_device{}()};
+
+    /// Updates the heading of every replica at an end of the ladder, counting the round trips it completes.
+    void trackRoundTrips();
+};
+}
+
+#endif //CASET_PARALLELTEMPERING_H
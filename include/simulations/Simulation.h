@@ -40,7 +40,7 @@ class Simulation {
     ///
     /// In Regge calculus we build an initial triangulation of the Spacetime.
     ///
-    virtual void tune();
+    virtual void tune() = 0;
 
     ///
     /// `thermalize` implements some kind of adjustment to the initial lattice.
@@ -50,7 +50,7 @@ class Simulation {
     ///
     /// For Regge calculus this can be a randomly applied variation in an initially fixed edge length triangulation.
     ///
-    virtual void thermalize();
+    virtual void thermalize() = 0;
 };
 }
 
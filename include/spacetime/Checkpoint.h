@@ -0,0 +1,259 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_CHECKPOINT_H
+#define CASET_CHECKPOINT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace caset {
+///
+/// # Checkpoint format
+///
+/// A checkpoint is a `Header`, a table of `SectionEntry`s and the sections themselves. Every section is a flat array
+/// of one of the records below, in native byte order, starting on an 8-byte boundary, so a mapped file can be read in
+/// place. Records refer to each other by their position in their section, never by pointer.
+///
+/// Variable-length relations (a simplex's vertices, a vertex's edges, ...) are stored as a count in the owning record
+/// and the targets, for all owners in order, in a section of their own. The targets of record i start at the sum of
+/// the counts before it.
+///
+/// Each section carries a checksum, and the table carries one of its own, so a file can be checked without
+/// interpreting any record. Files are tied to the version they were written with.
+namespace checkpoint {
+inline constexpr std::array<char, 8> kMagic{'C', 'A', 'S', 'E', 'T', 'C', 'K', 'P'};
+inline constexpr std::uint32_t kVersion = 1;
+/// Reads back differently on a machine of the other byte order.
+inline constexpr std::uint32_t kByteOrderMark = 0x01020304u;
+
+enum class Section : std::uint32_t {
+  /// One `StateRecord`.
+  State = 1,
+  /// `VertexRecord`s, listed vertices in ID order first.
+  Vertices = 2,
+  /// Doubles: each vertex's coordinates.
+  Coordinates = 3,
+  /// `EdgeRecord`s, listed edges in `EdgeList` order first.
+  Edges = 4,
+  /// `SimplexRecord`s, top simplices and their facets alike.
+  Simplices = 5,
+  /// Vertex indices of each simplex, in order.
+  SimplexVertices = 6,
+  /// Edge indices of each simplex, in order.
+  SimplexEdges = 7,
+  /// Simplex indices of each simplex's facets, in order.
+  SimplexFacets = 8,
+  /// Simplex indices of each simplex's cofaces.
+  SimplexCofaces = 9,
+  /// Edge indices of each vertex's out-edges, in order.
+  VertexOutEdges = 10,
+  /// Edge indices of each vertex's in-edges, in order.
+  VertexInEdges = 11,
+  /// Simplex indices of the simplices at each vertex, in order.
+  VertexSimplices = 12,
+  /// Simplex indices of the simplices at each edge, in order.
+  EdgeSimplices = 13,
+  /// `BucketRecord`s for the boundary, free-facet and internal indices.
+  Buckets = 14,
+  /// Simplex indices of each bucket's members, in sampling order.
+  BucketMembers = 15,
+  /// `SiteRecord`s, the move candidates of each move type in sampling order.
+  Sites = 16,
+  /// Vertex indices of each site.
+  SiteVertices = 17,
+  /// Unsigned 64-bit \f$ N_k \f$ for each k, as `Spacetime::getFaceCount` keeps them.
+  FaceCounts = 18,
+  /// `OrientationCountRecord`s.
+  OrientationCounts = 19,
+};
+
+inline constexpr std::size_t kNumSections = 19;
+
+struct Header {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::uint64_t fileSize;
+  std::uint32_t sections;
+  std::uint32_t reserved;
+  /// Of the section table.
+  std::uint64_t checksum;
+};
+
+struct SectionEntry {
+  std::uint32_t tag;
+  std::uint32_t recordSize;
+  std::uint64_t offset;
+  std::uint64_t count;
+  std::uint64_t checksum;
+};
+
+struct StateRecord {
+  std::uint64_t vertexIdCounter;
+  std::uint64_t currentTime;
+  std::uint64_t firstId;
+  std::uint64_t idBound;
+  std::uint64_t rngSeed;
+  std::uint64_t rngStream;
+  std::uint64_t rngPosition;
+  std::uint64_t siteSimplexSize;
+  double alpha;
+  std::uint32_t signatureDimensions;
+  std::uint8_t signatureType;
+  std::uint8_t coordinateFree;
+  std::uint8_t spacetimeType;
+  std::uint8_t reserved;
+};
+
+/// Set on vertices and edges that are in the `VertexList` or `EdgeList`, rather than only held by a simplex.
+inline constexpr std::uint32_t kListed = 1u;
+
+struct VertexRecord {
+  std::uint64_t id;
+  /// `Vertex::getTime`, for readers that don't want to interpret the coordinates.
+  double time;
+  std::uint32_t coordinates;
+  std::uint32_t outEdges;
+  std::uint32_t inEdges;
+  std::uint32_t simplices;
+  std::uint32_t flags;
+  std::uint32_t reserved;
+};
+
+struct EdgeRecord {
+  std::uint64_t source;
+  std::uint64_t target;
+  double squaredLength;
+  std::uint32_t simplices;
+  std::uint32_t flags;
+};
+
+struct SimplexRecord {
+  std::uint8_t vertices;
+  std::uint8_t ti;
+  std::uint8_t tf;
+  /// Bit i is set while facet i is free to glue.
+  std::uint8_t freeFacets;
+  std::uint32_t edges;
+  std::uint32_t facets;
+  std::uint32_t cofaces;
+};
+
+enum class BucketKind : std::uint8_t {
+  External = 0,
+  FreeFacet = 1,
+  Internal = 2
+};
+
+/// A bucket of one of the Spacetime's indices. External and internal buckets are keyed by orientation, free-facet
+/// buckets also by whether the facet is timelike and its earliest time.
+struct BucketRecord {
+  BucketKind kind;
+  std::uint8_t ti;
+  std::uint8_t tf;
+  std::uint8_t timelike;
+  std::uint32_t members;
+  std::uint64_t time;
+};
+
+struct SiteRecord {
+  /// A `MoveType`.
+  std::uint8_t move;
+  std::uint8_t vertices;
+  std::uint16_t reserved0;
+  std::uint32_t reserved1;
+};
+
+struct OrientationCountRecord {
+  std::uint64_t orientation;
+  std::uint64_t count;
+};
+
+/// @return A 64-bit checksum of `bytes`, eight bytes at a time.
+std::uint64_t checksum(std::span<const std::byte> bytes) noexcept;
+}
+
+///
+/// # Checkpoint
+///
+/// A checkpoint file mapped read-only into memory. Opening one checks the header, that every section lies within the
+/// file with the record size this build expects, and every checksum, but constructs nothing. `Spacetime::load` reads
+/// the sections from here.
+///
+/// Where the platform has no `mmap`, the file is read into memory instead.
+class Checkpoint {
+  public:
+    /// @throws std::runtime_error If the file can't be read or fails any check.
+    explicit Checkpoint(const std::string &path);
+
+    ~Checkpoint();
+
+    Checkpoint(const Checkpoint &) = delete;
+    Checkpoint &operator=(const Checkpoint &) = delete;
+
+    /// @return The records of section `tag`, which are empty if the file doesn't have it.
+    template<typename T>
+    [[nodiscard]] std::span<const T> get(checkpoint::Section tag) const {
+      const checkpoint::SectionEntry *entry = find(tag);
+      if (entry == nullptr) return {};
+      if (entry->recordSize != sizeof(T)) {
+        throw std::runtime_error("checkpoint section " + std::to_string(static_cast<std::uint32_t>(tag)) +
+                                 " has records of " + std::to_string(entry->recordSize) + " bytes, not " +
+                                 std::to_string(sizeof(T)));
+      }
+      return {reinterpret_cast<const T *>(bytes + entry->offset), static_cast<std::size_t>(entry->count)};
+    }
+
+    [[nodiscard]] const checkpoint::StateRecord &getState() const;
+
+    [[nodiscard]] std::size_t getVertexCount() const {
+      return get<checkpoint::VertexRecord>(checkpoint::Section::Vertices).size();
+    }
+
+    [[nodiscard]] std::size_t getEdgeCount() const {
+      return get<checkpoint::EdgeRecord>(checkpoint::Section::Edges).size();
+    }
+
+    [[nodiscard]] std::size_t getSimplexCount() const {
+      return get<checkpoint::SimplexRecord>(checkpoint::Section::Simplices).size();
+    }
+
+    [[nodiscard]] std::size_t getFileSize() const noexcept { return size; }
+
+  private:
+    const std::byte *bytes = nullptr;
+    std::size_t size = 0;
+    bool mapped = false;
+    std::vector<std::byte> buffer{};
+
+    [[nodiscard]] const checkpoint::SectionEntry *find(checkpoint::Section tag) const noexcept;
+
+    void validate(const std::string &path) const;
+};
+} // caset
+
+#endif // CASET_CHECKPOINT_H
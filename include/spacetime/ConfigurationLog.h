@@ -0,0 +1,224 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CASET_CONFIGURATIONLOG_H
+#define CASET_CONFIGURATIONLOG_H
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Fingerprint.h"
+
+namespace caset {
+class Spacetime;
+
+///
+/// # Configuration log format
+///
+/// A log is a `Header`, then `Chunk`s as they're written, then, once the log is closed, an index of every frame and a
+/// `Trailer`. Everything is in native byte order.
+///
+/// A chunk is a `ChunkHeader` and a payload of frames, each a varint byte count and that many bytes. A frame is a
+/// sequence of varints: the chain, the sweep, the vertices per simplex k, the number of orientation groups, then each
+/// group's (ti, tf, count), then the top simplices. Each simplex's vertex IDs are sorted, and the simplices are sorted
+/// by orientation and then lexicographically, so within a group the first ID is stored as the gap from the previous
+/// simplex's first ID and every other ID as the gap from the ID before it, less one. A simplex of small gaps takes a
+/// byte per vertex.
+///
+/// The index gives each frame's offset, size and checksum, so one frame can be read without touching the rest. A log
+/// whose writer died before the index was written can still be read up to the last complete chunk.
+namespace configlog {
+inline constexpr std::array<char, 8> kMagic{'C', 'A', 'S', 'E', 'T', 'L', 'O', 'G'};
+inline constexpr std::array<char, 8> kEndMagic{'C', 'A', 'S', 'E', 'T', 'E', 'N', 'D'};
+inline constexpr std::uint32_t kVersion = 1;
+inline constexpr std::uint32_t kByteOrderMark = 0x01020304u;
+inline constexpr std::uint32_t kChunkTag = 0x4b4e4843u;
+
+struct Header {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+};
+
+struct ChunkHeader {
+  std::uint32_t tag;
+  std::uint32_t frames;
+  std::uint64_t bytes;
+  /// `checkpoint::checksum` of the payload.
+  std::uint64_t checksum;
+};
+
+struct FrameEntry {
+  /// Of the frame's first byte, after its length.
+  std::uint64_t offset;
+  std::uint64_t sweep;
+  std::uint64_t checksum;
+  std::uint32_t bytes;
+  std::uint32_t chain;
+};
+
+struct Trailer {
+  std::uint64_t frames;
+  std::uint64_t indexOffset;
+  std::uint64_t indexChecksum;
+  std::array<char, 8> magic;
+};
+
+static_assert(sizeof(Header) == 16 && sizeof(ChunkHeader) == 24 && sizeof(FrameEntry) == 32 && sizeof(Trailer) == 32);
+}
+
+///
+/// # ConfigurationLog
+///
+/// Appends thinned configurations of one or more chains to a file without holding up the chains. `append` copies the
+/// top simplices' vertex IDs into a recycled buffer and queues it; a background thread sorts, encodes, checksums and
+/// writes them in chunks of about `chunkBytes`. At most `queueDepth` frames wait at once, after which `append` blocks
+/// until the writer catches up, so memory stays bounded when the disk can't keep pace.
+///
+/// `append` may be called from several threads, e.g. every worker of an `EnsembleRunner`. Errors on the writer thread
+/// are rethrown by the next call to `append`, `flush` or `close`.
+class ConfigurationLog {
+  public:
+    explicit ConfigurationLog(const std::string &path, std::size_t queueDepth = 64, std::size_t chunkBytes = 1 << 20);
+
+    ConfigurationLog(const ConfigurationLog &) = delete;
+    ConfigurationLog &operator=(const ConfigurationLog &) = delete;
+
+    /// Closes the log, swallowing any error. Call `close` to see them.
+    ~ConfigurationLog();
+
+    /// Queues the current configuration of `spacetime` as the next frame.
+    void append(Spacetime &spacetime, std::uint64_t sweep, std::uint32_t chain = 0);
+
+    /// Blocks until every frame appended so far is written to the file.
+    void flush();
+
+    /// Writes out the remaining frames and the index, and stops the writer. Later calls do nothing.
+    void close();
+
+    /// @return The number of frames appended so far.
+    [[nodiscard]] std::size_t size() const;
+
+  private:
+    struct Frame {
+      std::uint64_t sweep = 0;
+      std::uint32_t chain = 0;
+      /// Vertices per simplex.
+      std::uint32_t width = 0;
+      /// Per simplex, (ti << 8 | tf) and then its `width` vertex IDs.
+      std::vector<IdType> rows{};
+    };
+
+    std::ofstream out;
+    std::string path;
+    std::size_t queueDepth;
+    std::size_t chunkBytes;
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Frame> pending{};
+    /// Emptied frames, kept for their capacity.
+    std::vector<Frame> spare{};
+    std::size_t appended = 0;
+    std::size_t written = 0;
+    /// The most frames any `flush` has asked to see written.
+    std::size_t flushTarget = 0;
+    bool closing = false;
+    bool closed = false;
+    std::exception_ptr error{};
+    std::thread writer;
+
+    /// Touched only by the writer thread.
+    std::uint64_t offset = 0;
+    std::vector<std::uint8_t> chunk{};
+    std::uint32_t chunkFrames = 0;
+    std::vector<configlog::FrameEntry> index{};
+    std::vector<std::uint32_t> order{};
+    std::vector<std::uint8_t> scratch{};
+
+    void write();
+    void encode(Frame &frame);
+    void writeChunk();
+    void writeIndex();
+    /// Rethrows the writer's error, if any. Holds `mutex`.
+    void check() const;
+};
+
+///
+/// # ConfigurationReader
+///
+/// Reads the frames of a `ConfigurationLog` in any order. A log without an index (its writer was killed) is scanned
+/// chunk by chunk up to the first damaged or missing one; `isComplete` tells the two apart. Not safe to share between
+/// threads.
+class ConfigurationReader {
+  public:
+    ///
+    /// A decoded frame.
+    struct Frame {
+      std::uint64_t sweep = 0;
+      std::uint32_t chain = 0;
+      /// Vertices per simplex.
+      std::uint32_t width = 0;
+      /// `width` sorted vertex IDs per simplex.
+      std::vector<IdType> vertices{};
+      /// (ti, tf) per simplex.
+      std::vector<std::uint8_t> orientations{};
+    };
+
+    ///
+    /// @throws std::runtime_error If the file can't be opened or isn't a configuration log of this version.
+    explicit ConfigurationReader(const std::string &path);
+
+    ///
+    /// @throws std::out_of_range If there's no frame `i`.
+    /// @throws std::runtime_error If the frame doesn't match its checksum or doesn't decode.
+    [[nodiscard]] Frame getFrame(std::size_t i);
+
+    [[nodiscard]] std::uint64_t getSweep(std::size_t i) const { return index.at(i).sweep; }
+
+    [[nodiscard]] std::uint32_t getChain(std::size_t i) const { return index.at(i).chain; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return index.size(); }
+
+    /// @return Whether the log was closed and its index read, rather than recovered by scanning.
+    [[nodiscard]] bool isComplete() const noexcept { return complete; }
+
+  private:
+    std::ifstream in;
+    std::string path;
+    std::vector<configlog::FrameEntry> index{};
+    std::vector<std::uint8_t> buffer{};
+    bool complete = false;
+
+    bool readIndex(std::uint64_t size);
+    void scan(std::uint64_t size);
+};
+}
+
+#endif //CASET_CONFIGURATIONLOG_H
@@ -22,18 +22,29 @@
 #ifndef CASET_SPACETIME_H
 #define CASET_SPACETIME_H
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <random>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "topologies/Topology.h"
 #include "observables/Observable.h"
+#include "Job.h"
 #include "EdgeList.h"
 #include "VertexList.h"
 #include "Metric.h"
+#include "Pool.h"
+#include "Random.h"
+#include "SamplingIndex.h"
 #include "Simplex.h"
 #include "topologies/Toroid.h"
 
@@ -47,6 +58,91 @@ enum class SpacetimeType : uint8_t {
   RICCI_FLOW_DISCRETIZATION = 5
 };
 
+///
+/// What `Spacetime::buildBulk` did, and how long each phase of the create/choose/attach pipeline took in total.
+struct BuildStats {
+  /// Simplices created, including the seed and any that could not be glued.
+  std::size_t created = 0;
+  std::size_t glued = 0;
+  /// Simplices for which no compatible face was found on the boundary. The build stops at the first one.
+  std::size_t unmatched = 0;
+  /// Face pairs `causallyAttachFaces` refused.
+  std::size_t rejected = 0;
+  double createSeconds = 0.;
+  double chooseSeconds = 0.;
+  double attachSeconds = 0.;
+  /// Time spent merging and stitching slabs. Only `Spacetime::buildSlabs` sets this.
+  double mergeSeconds = 0.;
+};
+
+///
+/// How `Spacetime::embed` lays out the complex.
+struct EmbeddingOptions {
+  /// Coordinates per vertex, the first of which is the vertex's time.
+  int dimensions = 4;
+  std::size_t maxIterations = 1000;
+  /// Stop once an iteration lowers the stress by less than this fraction of it.
+  double tolerance = 1e-6;
+  /// Stop after this many seconds. 0 means no limit.
+  double timeBudget = 0.;
+  /// Worker threads; one per hardware thread when 0.
+  std::size_t threads = 0;
+  /// The smallest target distance an edge gets, so null edges don't pull their vertices onto one point.
+  double epsilon = 1e-8;
+  /// The weight of the same-slice repulsion between vertices closer than `repulsionCutoff`. 0 turns it off.
+  double repulsion = 0.;
+  double repulsionCutoff = 1.;
+  /// Start from the last `embed`'s layout and refit only what has changed since, out to `hops` edges away.
+  bool incremental = false;
+  std::size_t hops = 2;
+  /// Seeds the random start. Unset, the start comes from a stream split off the Spacetime's seed, so it's reproducible
+  /// without drawing from the generator the moves use.
+  std::optional<std::uint64_t> seed{};
+};
+
+///
+/// What `Spacetime::embed` did.
+struct EmbeddingStats {
+  std::size_t iterations = 0;
+  /// The weighted stress of the final layout. See `Spacetime::embed`.
+  double stress = 0.;
+  double seconds = 0.;
+  /// The vertices that were fitted: every vertex, or the neighbourhood an incremental embed refit.
+  std::size_t vertices = 0;
+  /// Whether the stress settled within `EmbeddingOptions::tolerance`, rather than running out of iterations or time.
+  bool converged = false;
+};
+
+///
+/// The local moves of `Spacetime`, by the name `CDT` gives them.
+enum class MoveType : uint8_t {
+  /// `Spacetime::insertVertex`
+  Add = 0,
+  /// `Spacetime::removeVertex`
+  Remove = 1,
+  /// `Spacetime::flipSpatialFace` below the top spatial dimension
+  Flip = 2,
+  /// `Spacetime::flipTimelikeFace` at a timelike facet
+  Shift = 3,
+  /// `Spacetime::flipTimelikeFace` at a smaller timelike face
+  Ishift = 4
+};
+
+inline constexpr std::size_t kNumMoveTypes = 5;
+
+///
+/// How a move changes the counts `Spacetime::action` depends on. See `Spacetime::countChange`.
+struct CountChange {
+  /// \f$ \Delta N_0 \f$
+  std::int64_t vertices = 0;
+  /// \f$ \Delta N_d \f$
+  std::int64_t simplices = 0;
+  /// \f$ \Delta N_d^{(d, 1)} \f$, the change in (d, 1) and (1, d) simplices.
+  std::int64_t spatialCones = 0;
+  /// The change in the number of candidate sites of the inverse move, the one that undoes this move at B.
+  std::int64_t inverseSites = 0;
+};
+
 ///
 /// # Spacetime
 ///
@@ -91,6 +187,7 @@ class Spacetime {
       currentTime++;
       return static_cast<double>(currentTime);
     }
+    /// Creates an Edge with a squared length drawn from the Spacetime's generator, so `seed` reproduces it.
     EdgePtr createEdge(const std::uint64_t src, const std::uint64_t tgt);
     EdgePtr createEdge(const std::uint64_t src, const std::uint64_t tgt, double squaredLength) noexcept;
     void addObservable(const std::shared_ptr<Observable> &observable) { observables.push_back(observable); }
@@ -100,6 +197,38 @@ class Spacetime {
     /// matching the chosen topology. The default Topology is Toroid.
     void build(int numSimplices=3);
 
+    ///
+    /// Creates a simplex for each (ti, tf) orientation in `schedule` and glues it onto the boundary, pre-sizing storage
+    /// for the whole schedule first. If nothing has been created in this Spacetime yet, the first entry seeds the
+    /// complex. Stops at the first simplex that has nowhere to glue.
+    ///
+    /// This doesn't touch Python, so the bindings run it with the GIL released.
+    ///
+    /// @param progress If given, counts each simplex glued, and stops the build before the next simplex once cancelled.
+    BuildStats buildBulk(const std::vector<std::tuple<uint8_t, uint8_t> > &schedule, Progress *progress = nullptr);
+
+    ///
+    /// Builds `slabs` slabs [t, t+1], starting at the current time, each from `schedule` as in `buildBulk`, then
+    /// stitches neighbouring slabs together by identifying the vertices of the slice they share.
+    ///
+    /// Each slab is built into its own Spacetime, with its own pools and vertex ID range, on one of `threads` worker
+    /// threads (one per hardware thread when 0). The merge adopts their storage without copying records; handles
+    /// issued by the slabs are re-issued by this Spacetime's pools.
+    ///
+    /// Stitching walks each shared slice as a path, so only 2D schedules of (1, 2) and (2, 1) simplices are supported,
+    /// and `schedule` has to leave as many vertices on a slab's upper slice as on its lower one. The Spacetime must be
+    /// empty.
+    ///
+    /// @param progress If given, counts the simplices each slab glues. Once cancelled, the slabs stop and are dropped
+    ///   without being merged, leaving the Spacetime empty.
+    /// @return The slabs' stats summed. Phase times are summed across workers, so they measure work rather than
+    ///   elapsed time.
+    BuildStats buildSlabs(
+      const std::vector<std::tuple<uint8_t, uint8_t> > &schedule,
+      std::size_t slabs,
+      std::size_t threads = 0,
+      Progress *progress = nullptr);
+
     ///
     /// This method identifies a pair of faces (one from each simplex) that can be glued together while preserving the
     /// orientation of the simplices. The method checks for matching orientations and edge lengths to ensure
@@ -204,14 +333,57 @@ class Spacetime {
     SimplexSet getExternalSimplices()
     noexcept;
 
+    ///
+    /// Lays the vertices out in `dimensions` Euclidean dimensions so that each edge's length approaches
+    /// \f$ \sqrt{|l^2|} \f$, and stores the layout as their coordinates. The first coordinate is the vertex's time.
+    ///
+    /// With torch this fits the layout with Adam through autograd, until the loss stops changing by more than
+    /// `epsilon`. Without torch it calls `embed` and copies its layout into the vertices.
     void embedEuclidean(int dimensions, double epsilon);
 
+    ///
+    /// Lays the vertices out as `embedEuclidean` does, by stress majorization (SMACOF) over the edge list. The stress
+    /// is
+    ///
+    /// \f[
+    /// \sigma(X) = \sum_{(i, j) \in E} w_{ij} \left( \lVert x_i - x_j \rVert - d_{ij} \right)^2,
+    ///   \quad d_{ij} = \sqrt{\max(|l^2_{ij}|, \epsilon)}, \quad w_{ij} = d_{ij}^{-2}
+    /// \f]
+    ///
+    /// Each iteration moves every vertex to the weighted mean of where its neighbours would put it (the Guttman
+    /// transform, solved with one Jacobi step), which never raises the stress. Times stay fixed. Vertices are split
+    /// across `options.threads` workers, which share one contiguous coordinate buffer and sync once per iteration.
+    ///
+    /// Edges alone let a slice fold onto itself. A positive `options.repulsion` adds
+    /// \f$ w_r \max(0, r - \lVert x_i - x_j \rVert)^2 \f$ for every pair of vertices on the same slice, where r is
+    /// `options.repulsionCutoff`, and the transform treats each pair closer than r as an edge of length r. Each
+    /// iteration buckets every slice into a uniform grid of cells r wide and only compares vertices in neighbouring
+    /// cells. At bounded density that makes the comparisons O(N) expected rather than O(N^2); filing the cells is a
+    /// sort of their keys, O(N log N) but cheap beside them. Slices are then the unit of work the threads share.
+    /// Pairs crossing the cutoff can raise the stress, so with repulsion an iteration only usually lowers it.
+    ///
+    /// The layout is kept by the Spacetime (see `getLayoutArray`) rather than written into the vertices, whose
+    /// coordinates carry their time. It isn't part of the complex, so `clone` and `save` leave it behind.
+    ///
+    /// Layouts start at random from a Philox stream of their own: `options.seed`'s, or one split from the Spacetime's
+    /// seed. Either way they're reproducible whatever the thread count, and embedding leaves the moves' draws alone.
+    /// This doesn't need torch or Python; the bindings run it with the GIL released.
+    ///
+    /// With `options.incremental`, an embed picks up from the last layout of as many dimensions instead, and falls back
+    /// to a full one if there's none. Alongside the layout, each embed keeps a hash of every vertex's neighbours' IDs,
+    /// so one pass over the edges finds the vertices that are new or whose edges changed since. Each new vertex starts
+    /// at the barycenter of its placed neighbours, nudged at random so that twins don't coincide. Only the vertices
+    /// within `options.hops` edges of a changed one are refit; the rest hold still and anchor them. The stress, then,
+    /// covers only the pairs with an end among the refit vertices, and a stretch of steady layout costs a pass over
+    /// the edges and no iterations at all.
+    EmbeddingStats embed(const EmbeddingOptions &options = {});
+
     /// This method chooses a simplex from the boundary of the simplicial complex to which `unattachedSimplex` can be
-    /// glued. It does this by iterating through the `externalSimplices` and checking for compatible orientations and
-    /// edge lengths.
+    /// glued. For each free facet of `unattachedSimplex` it looks up the free boundary facets with the same orientation
+    /// and time signature and draws one uniformly at random. If a few draws only turn up facets of `unattachedSimplex`
+    /// itself it scans the bucket from a random offset, so a compatible face is always found if one exists.
     ///
-    /// To the extent the hashing function for vertex fingerprinting is good; this should be pretty well pseudo-random.
-    /// If you want something truly random, though, you should probably implement that.
+    /// Draws come from the Spacetime's generator; call `seed` for a reproducible build.
     ///
     /// @returns A pair of \f$ k-1 \f$ simplices (faces) if a compatible k-simplex was found. None otherwise.
     OptionalSimplexPair chooseSimplexFacesToGlue(const SimplexPtr &unattachedSimplex);
@@ -221,9 +393,395 @@ class Spacetime {
 
     [[nodiscard]] std::vector<Vertices> getConnectedComponents() const;
 
+    /// @return The Vertex addressed by `handle`, or nullptr if it's invalid or stale.
+    /// @throws std::invalid_argument If `handle` isn't one of this Spacetime's vertex handles.
+    [[nodiscard]] VertexPtr getVertex(Handle handle) const { return resolve(*vertexPool, handle); }
+
+    /// @return The Edge addressed by `handle`, or nullptr if it's invalid or stale.
+    /// @throws std::invalid_argument If `handle` isn't one of this Spacetime's edge handles.
+    [[nodiscard]] EdgePtr getEdge(Handle handle) const { return resolve(*edgePool, handle); }
+
+    /// @return The Simplex addressed by `handle`, or nullptr if it's invalid or stale.
+    /// @throws std::invalid_argument If `handle` isn't one of this Spacetime's simplex handles.
+    [[nodiscard]] SimplexPtr getSimplex(Handle handle) const { return resolve(*simplexPool, handle); }
+
+    ///
+    /// Pre-sizes the vertex, edge and simplex pools so a build of known size doesn't grow them chunk by chunk. Simplex
+    /// capacity should include facets, which are pooled alongside the top-dimensional simplices.
+    void reserve(std::size_t vertices, std::size_t edges, std::size_t simplices);
+
+    ///
+    /// Renumbers the live vertices 0..N-1 (in their current order), dropping the tombstones that gluing leaves in the
+    /// VertexList. Every Edge endpoint, Simplex ID lookup and fingerprint, and the fingerprint-keyed sets that depend
+    /// on them are rewritten in the same pass, and the vertex ID counter restarts at N.
+    ///
+    /// The layout from `embed` follows its vertices, but the neighbour hashes it was fit against don't survive the
+    /// renumbering, so the next incremental embed refits every vertex, from where it was.
+    ///
+    /// Any IDs held outside the Spacetime are invalidated. Handles are not affected.
+    void compact();
+
+    ///
+    /// A deep copy: every vertex, edge and simplex (facets included) with its links, the boundary, internal and
+    /// move-site indices, the counts and the generator state. Vertex IDs are kept, and each record's copy is found
+    /// through its pool handle, so the copy is a single linear pass with no hashing of the original records.
+    ///
+    /// That pass still allocates every record and its link containers and remaps every link, so it costs about 12 us
+    /// per triangle of a 2D strip on one core (see benchmarks/clone): far less than building and thermalizing again,
+    /// but over 10 s, not under 1, for a million simplices.
+    ///
+    /// The copy has its own pools and shares nothing mutable with this Spacetime, so the two can be evolved on
+    /// different threads. The metric, topology and observables are shared. Handles issued by this Spacetime don't
+    /// address the copy's records. Its generator continues from the same state, so seed it to fork a separate chain.
+    [[nodiscard]] std::shared_ptr<Spacetime> clone() const;
+
+    /// Writes a checkpoint of the whole state to `path`: every vertex, edge and simplex (facets included) with their
+    /// links, the boundary, internal and move-site indices, the counts and the generator position. The metric's
+    /// signature is kept; the topology and observables are not. See `Checkpoint` for the layout.
+    ///
+    /// The file is written next to `path` and renamed over it once complete, so an interrupted save leaves any
+    /// previous checkpoint intact.
+    void save(const std::string &path) const;
+
+    /// Restores a Spacetime written by `save`. It carries on exactly where the saved one left off: vertex IDs, the
+    /// order of every adjacency and sampling index, and the generator position are all kept. Records and indices are
+    /// rebuilt in one pass over the file.
+    ///
+    /// @param topology Defaults to a Toroid, as for a new Spacetime.
+    /// @throws std::runtime_error If the file fails validation or its records are inconsistent.
+    static std::shared_ptr<Spacetime> load(const std::string &path,
+                                           std::optional<std::shared_ptr<Topology> > topology = std::nullopt);
+
+    ///
+    /// # Arrays
+    ///
+    /// Flat, row-major copies of the complex, built in one pass each so that bindings can hand them to NumPy whole
+    /// instead of one object at a time. Vertex rows are the live vertices in ID order, as `getVertexIdArray` lists
+    /// them; the edge and simplex arrays refer to vertices by row, so they index the vertex arrays directly.
+
+    /// @return The ID of each vertex row.
+    [[nodiscard]] std::vector<std::int64_t> getVertexIdArray() const;
+
+    /// @return `Vertex::getTime` of each vertex row.
+    [[nodiscard]] std::vector<double> getTimeArray() const;
+
+    /// @return The most coordinates any vertex has: the number of columns of `getCoordinateArray`.
+    [[nodiscard]] std::size_t getCoordinateWidth() const noexcept;
+
+    /// @return (V, `getCoordinateWidth()`) coordinates, padded with NaN for vertices that have fewer.
+    [[nodiscard]] std::vector<double> getCoordinateArray() const;
+
+    /// @return (E, 2) source and target vertex rows, in `EdgeList` order.
+    [[nodiscard]] std::vector<std::int64_t> getEdgeArray() const;
+
+    /// @return The squared length of each edge, in `EdgeList` order.
+    [[nodiscard]] std::vector<double> getSquaredLengthArray() const;
+
+    /// @return (N, `getDimension()` + 1) vertex rows of the top simplices, each in the simplex's own vertex order.
+    [[nodiscard]] std::vector<std::int64_t> getSimplexArray() const;
+
+    /// @return The number of columns of `getLayoutArray`: `EmbeddingOptions::dimensions` of the last `embed`, or 0.
+    [[nodiscard]] std::size_t getLayoutDimensions() const noexcept { return layoutDimensions; }
+
+    /// @return (V, `getLayoutDimensions()`) positions from the last `embed`, NaN for vertices created since.
+    [[nodiscard]] std::vector<double> getLayoutArray() const;
+
+    ///
+    /// Builds a Spacetime from top simplices given as rows of vertex indices, the inverse of `getSimplexArray`. Vertex
+    /// i gets ID i and time `times[i]`. Every edge is created once, and facets shared by two rows are glued by sorting
+    /// all facets, so the whole import is O(N log N) and nothing is searched for a partner. The boundary, free-facet
+    /// and internal indices and the counts come out as though the complex had been built and glued face by face.
+    ///
+    /// @param times Whole, non-negative slice labels.
+    /// @param simplices (N, `width`) row-major vertex indices. Each row must span two neighbouring slices.
+    /// @param squaredLengths Optional (N, `width` choose 2) squared lengths of each row's edges, for the vertex pairs
+    ///   (0, 1), (0, 2), ..., (1, 2), ... in row order. Rows sharing an edge must agree on it. Without them, an edge gets
+    ///   alpha, negated if it's timelike under a Lorentzian metric, as the moves give new edges.
+    /// @throws std::invalid_argument If the rows aren't a causal simplicial manifold with boundary: an index out of
+    ///   range, a repeated vertex or row, a row off one slab, or a facet shared by more than two rows.
+    static std::shared_ptr<Spacetime> fromArrays(std::span<const double> times, std::span<const std::int64_t> simplices,
+                                                 std::size_t width, std::span<const double> squaredLengths = {});
+
+    /// Calls `visit` on each top simplex once, from its lowest-numbered vertex.
+    template<typename F>
+    void forEachTopSimplex(F &&visit) const {
+      const std::size_t width = getDimension() + 1;
+      vertexList->forEach([&](const VertexPtr &vertex) {
+        const IdType id = vertex->getId();
+        for (const auto &simplex : vertex->getSimplices()) {
+          const Vertices &vertices = simplex->getVertices();
+          if (vertices.size() != width) continue;
+          if (std::ranges::any_of(vertices, [&](const VertexPtr &other) { return other->getId() < id; })) continue;
+          visit(simplex);
+        }
+      });
+    }
+
+    /// Seeds the generator used to pick gluing sites, at the start of `stream` under `value`.
+    void seed(std::uint64_t value, std::uint64_t stream = 0) { rng.seed(value, stream); }
+
+    ///
+    /// # Counts
+    ///
+    /// The f-vector and the per-orientation simplex counts are kept up to date by `createSimplex`,
+    /// `causallyAttachFaces` and the moves, so none of the queries below walk the complex.
+    ///
+    /// Faces of dimension 2 up to the top dimension aren't stored as objects, so they're counted from the simplices
+    /// that contain them. That assumes the faces of a simplex passed to `createSimplex` are new, as they are for
+    /// everything the builders create, and that gluing two facets identifies only the faces of those facets.
+
+    /// @return The number of k-faces, \f$ N_k \f$.
+    [[nodiscard]] std::size_t getFaceCount(std::size_t k) const noexcept;
+
+    /// @return The dimension of the largest simplex created, at least 1.
+    [[nodiscard]] std::size_t getDimension() const noexcept { return std::max<std::size_t>(faceCounts.size(), 2) - 1; }
+
+    /// @return \f$ (N_0, N_1, \ldots, N_d) \f$, where d is `getDimension()`.
+    [[nodiscard]] std::vector<std::size_t> getFVector() const;
+
+    /// @return The number of simplices with exactly this (ti, tf) orientation.
+    [[nodiscard]] std::size_t getSimplexCount(const std::tuple<uint8_t, uint8_t> &orientation) const noexcept;
+
+    /// @return \f$ \chi = \sum_k (-1)^k N_k \f$.
+    [[nodiscard]] std::int64_t getEulerCharacteristic() const noexcept;
+
+    ///
+    /// The bare CDT action,
+    ///
+    /// \f[
+    /// S = -(\kappa_0 + 6 \Delta) N_0 + (\kappa_4 + \Delta) N_d + \Delta N_d^{(d, 1)}
+    /// \f]
+    ///
+    /// where \f$ N_d^{(d, 1)} \f$ counts the (d, 1) and (1, d) simplices. In 4D these are the (4, 1) simplices and
+    /// \f$ \Delta \f$ is the asymmetry between the lengths of timelike and spacelike edges. This is
+    /// \f$ \kappa_4 N_4 + \Delta (2 N_4^{(4, 1)} + N_4^{(3, 2)}) \f$ with \f$ N_4 = N_4^{(4, 1)} + N_4^{(3, 2)} \f$. The
+    /// same form is used unchanged in lower dimensions.
+    ///
+    /// @see "Nonperturbative Quantum Gravity", J. Ambjorn, A. Gorlich, J. Jurkiewicz, R. Loll, 2012. Section 4.
+    [[nodiscard]] double action(double kappa0, double delta, double kappa4) const noexcept;
+
+    /// @return How much `action` changes when its counts change by `change`. `action` is this for the counts
+    ///   themselves, so the two can't disagree.
+    [[nodiscard]] static double actionChange(const CountChange &change, double kappa0, double delta,
+                                             double kappa4) noexcept;
+
+    ///
+    /// # Moves
+    ///
+    /// Each move below replaces the star of one face (every top simplex containing it) with a new set of simplices
+    /// that has the same boundary. They're local rewrites: only the star, the facets of its neighbours and the edges
+    /// inside it are touched, and a move that isn't legal at the given face returns false without changing anything.
+    ///
+    /// All of them preserve the foliation. Bulk flips only create and destroy timelike faces, and the moves that change
+    /// a spatial slice change it by a Pachner move that is coned off to the slices on either side.
+    ///
+    /// @see "Dynamically Triangulating Lorentzian Quantum Gravity", J. Ambjorn, J. Jurkiewicz, R. Loll, 2001. Section 3.
+
+    ///
+    /// The (2, 2d) move. Splits the spatial face `face`, d vertices on one slice, with a new vertex. The face must be
+    /// shared by one simplex above the slice and one below, and each of them is split into d simplices. This is the
+    /// (2, 4) move in 2D and (2, 6) in 3D.
+    /// @return The new vertex, or nullptr if `face` isn't an interior spatial face.
+    VertexPtr insertVertex(const Vertices &face);
+
+    /// The (2d, 2) move, the inverse of `insertVertex`. `vertex` must have exactly d neighbours on its own slice and
+    /// one on each neighbouring slice, and those d neighbours must not already share a face.
+    bool removeVertex(const VertexPtr &vertex);
+
+    ///
+    /// A Pachner move within a spatial slice, coned off to the slices above and below. `face` (on one slice) must have
+    /// a star made only of (d, 1) and (1, d) simplices, which all share one apex on either side. The spatial star is
+    /// then replaced by its complementary Pachner move. With an edge in 3D this is the (4, 4) move.
+    bool flipSpatialFace(const Vertices &face);
+
+    ///
+    /// A Pachner (bistellar) move at a timelike face: the star of `face`, A * dB, becomes B * dA, where B are the other
+    /// vertices of the star. B must also be timelike and must not already be a face. At a timelike facet this is the
+    /// (2, 2) move in 2D and (2, 3) in 3D; at a timelike edge of a 3D complex it's (3, 2).
+    bool flipTimelikeFace(const Vertices &face);
+
+    ///
+    /// The number of candidate sites for `move`. A face A of a d-dimensional complex is a candidate when its order, the
+    /// number of d-simplices containing it, is the size of the star the move replaces:
+    ///
+    ///  - a spatial face of d vertices with order 2 is an `Add` site,
+    ///  - a spatial face of k vertices, 1 < k < d, with order 2(d + 1 - k) is a `Flip` site,
+    ///  - a vertex with order 2d is a `Remove` site,
+    ///  - a timelike face of d vertices with order 2 is a `Shift` site,
+    ///  - a timelike face of k vertices, 1 < k < d, with order d + 2 - k is an `Ishift` site,
+    ///
+    /// so in 2D the `Remove` sites are the vertices of coordination 4, and in 3D the `Flip` sites are the spatial edges
+    /// of order 4. The move itself still checks the rest of its conditions (that the star is causally shaped and B
+    /// isn't already a face), which candidates almost always meet.
+    ///
+    /// The candidates are indexed by the first call to this or `sampleMoveSite`. From then on the moves, gluing and
+    /// `createSimplex` re-file the faces whose order they change, so the index never needs a scan; `compact` rebuilds
+    /// it. With a uniform draw from it the probability of proposing a given site is one over this count.
+    std::size_t countMoveSites(MoveType move);
+
+    /// @return The vertices of a candidate site for `move` drawn uniformly at random, or nothing if there are none.
+    std::optional<Vertices> sampleMoveSite(MoveType move, Rng &generator);
+
+    ///
+    /// How making `move` at the candidate site `site` would change the action's counts and the number of sites of its
+    /// inverse, without making it. Each move replaces the star {A + (B - b) + c} of A = `site` with
+    /// {B + (A - a) + c}, for a in A, b in B and, for the moves on a slice, the cones c above and below it. This
+    /// works out both sets of simplices from the star, and reads the counts off their vertices' times.
+    ///
+    /// Only the faces of those simplices change order, so the inverse's sites are recounted among them: each face's
+    /// order now, less the old simplices containing it, plus the new ones. That is what a Metropolis test needs for the
+    /// inverse's proposal probability, since a move can also make or unmake sites other than B, e.g. an `Add` raises
+    /// the order of both cones, which may have been `Remove` sites.
+    ///
+    /// The result is only meaningful for a legal move; it doesn't check the move's conditions.
+    [[nodiscard]] CountChange countChange(MoveType move, const Vertices &site) const;
+
   private:
-    std::shared_ptr<EdgeList> edgeList = std::make_shared<EdgeList>();
-    std::shared_ptr<VertexList> vertexList = std::make_shared<VertexList>();
+    ///
+    /// Facets can only be glued to facets with the same orientation and time signature: whether all their vertices lie
+    /// on one slice, and which slab they span. That is the key for `freeFacets`.
+    struct FacetKey {
+      std::uint8_t ti;
+      std::uint8_t tf;
+      bool timelike;
+      /// The earliest time of any vertex of the facet.
+      std::uint64_t time;
+
+      bool operator==(const FacetKey &other) const noexcept = default;
+    };
+
+    struct FacetKeyHash {
+      std::size_t operator()(const FacetKey &key) const noexcept {
+        const std::size_t packed = static_cast<std::size_t>(key.ti) << 9 | static_cast<std::size_t>(key.tf) << 1 |
+                                   key.timelike;
+        return packed ^ key.time * 0x9E3779B97F4A7C15ull;
+      }
+    };
+
+    /// @return The key for `facet`, or nothing if it's degenerate (all its vertices on one slice) and can't be glued.
+    static std::optional<FacetKey> facetKeyOf(const SimplexPtr &facet);
+
+    /// Adds the free, gluable facets of a newly created `simplex` to `freeFacets`.
+    void registerFreeFacets(const SimplexPtr &simplex);
+
+    /// Drops `simplex` from every `externalSimplices` bucket it was registered under by `createSimplex`.
+    void removeFromBoundary(const SimplexPtr &simplex);
+
+    ///
+    /// Bookkeeping once two faces have been identified: `attachedFace` takes on the cofaces of `unattachedFace`, both
+    /// leave `freeFacets`, and the simplices on either side mark the facet glued.
+    void sealFace(const SimplexPtr &attachedFace, const SimplexPtr &unattachedFace);
+
+    /// Replaces `from` with `to` in every edge and simplex and drops `from`. This is the identification
+    /// `attachAtVertices` performs, without a face driving it.
+    void identifyVertices(const VertexPtr &from, const VertexPtr &to);
+
+    ///
+    /// Takes `simplices`, whose vertices are about to be renamed, out of `internalSimplices`. Everything else keyed by
+    /// their fingerprints is re-bucketed by `refileRenamed` once they have been.
+    /// @return Which of them were there.
+    std::vector<bool> unfileRenamed(const Simplices &simplices);
+
+    /// Files `simplices` again after their vertices were renamed, and re-buckets every co-face set holding them.
+    void refileRenamed(const Simplices &simplices, const std::vector<bool> &internal);
+
+    /// Swaps the direction of an indexed edge, keeping the EdgeList and vertex adjacency consistent.
+    void reverseEdge(const EdgePtr &edge);
+
+    /// @return The vertices at `time` in order along the slice, which must be an open path of spacelike edges.
+    [[nodiscard]] Vertices walkSlice(double time) const;
+
+    /// Identifies the vertices of `upper` (the lower slice of one slab) with those of `lower` (the upper slice of the
+    /// slab beneath it), in order, and seals the spacelike faces they now share.
+    void stitchSlice(const Vertices &lower, const Vertices &upper);
+
+    /// Moves the records and indices of `slab` into this Spacetime. Their vertex IDs must not overlap.
+    void absorb(Spacetime &slab);
+
+    /// Registers a simplex with free facets in `externalSimplices`. The inverse of `removeFromBoundary`.
+    void addToBoundary(const SimplexPtr &simplex);
+
+    /// @return The simplices of `size` vertices that contain every vertex of `face`.
+    [[nodiscard]] static Simplices simplicesContaining(const Vertices &face, std::size_t size);
+
+    /// @return How many simplices of `size` vertices contain every vertex of `face`, without collecting them.
+    [[nodiscard]] static std::size_t countSimplicesContaining(const Vertices &face, std::size_t size) noexcept;
+
+    /// @return The number of vertices in the largest simplices incident to `vertex`.
+    [[nodiscard]] static std::size_t topSizeAt(const VertexPtr &vertex) noexcept;
+
+    /// The squared length new edges between these vertices get: spacelike within a slice, timelike across slices.
+    [[nodiscard]] double squaredLengthBetween(const VertexPtr &a, const VertexPtr &b) const;
+
+    /// Drops an edge from the EdgeList and the adjacency of both its endpoints.
+    void removeEdge(const EdgePtr &edge);
+
+    ///
+    /// Replaces `star`, the simplices {A + (B - b) + c}, with {B + (A - a) + c} for every a in A, b in B and cone vertex
+    /// c (or no cone vertex if `cones` is empty). Faces containing A are dropped and faces containing B are created.
+    /// Facets on the boundary of the star are glued to the same neighbours afterwards, or stay free. The caller checks
+    /// that the move is legal.
+    void exchangeStar(const Vertices &a, const Vertices &b, const Vertices &cones, const Simplices &star);
+
+    /// Detaches a simplex of a star being replaced from the vertices, its neighbours and the boundary and glued-face
+    /// indices. `across` maps the fingerprint of each facet on the star's boundary to the simplex on its other side.
+    void retireSimplex(const SimplexPtr &simplex, const std::unordered_map<std::uint64_t, SimplexPtr> &across);
+
+    /// Glues facet `i` of `simplex` to the matching facet of `neighbour`.
+    void glueFacet(const SimplexPtr &simplex, std::size_t i, const SimplexPtr &neighbour);
+
+    /// Files a face shared by two simplices under `internalSimplices`.
+    void recordInternal(const SimplexPtr &face);
+
+    /// Drops a face from `internalSimplices`.
+    /// @return Whether it was there.
+    bool forgetInternal(const SimplexPtr &face);
+
+    /// Hashes a move site, the fingerprint of its vertex IDs.
+    struct SiteHash {
+      std::size_t operator()(const SimplexFingerprint &site) const noexcept { return site.fingerprint(); }
+    };
+
+    /// Faces collected for `refreshSites`. They may repeat.
+    using SiteList = std::vector<SimplexFingerprint>;
+
+    /// Builds `moveSites` from every top simplex.
+    void indexMoveSites();
+
+    /// Adds the faces of the top simplices among `simplices` to `sites`.
+    void collectSites(const Simplices &simplices, SiteList &sites) const;
+
+    /// Adds the faces of the top simplices at any of `vertices` to `sites`.
+    void collectSitesAround(const Vertices &vertices, SiteList &sites) const;
+
+    /// Re-files each of `sites` under the move its current order allows, if any, and drops faces that no longer exist.
+    /// Sorts and de-duplicates `sites` first.
+    void refreshSites(SiteList &sites);
+
+    /// Adds `delta` faces with `size` vertices to the f-vector. Vertices and edges are counted by their lists instead.
+    void countFaces(std::size_t size, std::int64_t delta);
+
+    /// Adds `delta` to the count of simplices oriented like `simplex`.
+    void countOrientation(const SimplexPtr &simplex, std::int64_t delta);
+
+    /// @return The record `pool` addresses by `handle`. See `getVertex`.
+    template<typename T>
+    static std::shared_ptr<T> resolve(const Pool<T> &pool, const Handle handle) {
+      if (handle.valid() && !pool.owns(handle)) {
+        throw std::invalid_argument("Handle " + std::to_string(handle.raw()) + " belongs to another pool");
+      }
+      return pool.lock(handle);
+    }
+
+    ///
+    /// Every Vertex, Edge and Simplex created through this Spacetime lives in one of these pools. They're declared
+    /// ahead of the lists that allocate from them.
+    std::shared_ptr<Pool<Vertex> > vertexPool = std::make_shared<Pool<Vertex> >();
+    std::shared_ptr<Pool<Edge> > edgePool = std::make_shared<Pool<Edge> >();
+    std::shared_ptr<Pool<Simplex> > simplexPool = std::make_shared<Pool<Simplex> >();
+
+    std::shared_ptr<EdgeList> edgeList = std::make_shared<EdgeList>(edgePool);
+    std::shared_ptr<VertexList> vertexList = std::make_shared<VertexList>(vertexPool);
 
     IdType vertexIdCounter = 0;
     SpacetimeType spacetimeType;
@@ -231,15 +789,30 @@ class Spacetime {
     std::shared_ptr<Metric> metric;
     std::shared_ptr<Topology> topology;
     std::uint64_t currentTime = 0;
+    Rng rng{std::random_device{}()};
+
+    /// The last `embed`'s positions, `layoutDimensions` per vertex ID.
+    std::vector<double> layout{};
+    std::size_t layoutDimensions = 0;
+    /// Per vertex ID, a hash of its neighbours' IDs when `layout` was fit, for incremental embeds to compare against.
+    std::vector<std::uint64_t> layoutSignatures{};
 
     ///
     /// These are simplices on the boundary of a simplicial complex. They have at least one external face, and hence can
     /// be glued to other simplices. The externalSimplices are organized by the orientation of their available faces. If
-    /// a face is available; the orientation of that face can be found as a key corresponding to a SimplexSet containing
-    /// the Simplex to which that Face belongs.
+    /// a face is available; the orientation of that face can be found as a key corresponding to a SamplingIndex
+    /// containing the Simplex to which that Face belongs.
+    ///
+    /// This makes for fast lookups when gluing simplices together to form a complex, and lets us pick a gluing site
+    /// uniformly at random in O(1). A simplex is dropped from every bucket once none of its facets are available.
+    std::unordered_map<SimplexOrientationPtr, SamplingIndex<SimplexPtr>, SimplexOrientationHash, SimplexOrientationEq>
+    externalSimplices{};
+
     ///
-    /// This makes for fast lookups when gluing simplices together to form a complex.
-    std::unordered_map<SimplexOrientationPtr, SimplexSet, SimplexOrientationHash, SimplexOrientationEq> externalSimplices{};
+    /// Every free facet on the boundary, keyed by what it can be glued to. Each facet has exactly one coface, the
+    /// boundary simplex it belongs to. Glued facets are removed in `causallyAttachFaces`, so finding a partner for a
+    /// facet of a new simplex is one lookup and one uniform draw.
+    std::unordered_map<FacetKey, SamplingIndex<SimplexPtr>, FacetKeyHash> freeFacets{};
 
     ///
     /// These are simplices that are fully internal to the simplicial complex. They have no external faces, and hence
@@ -249,6 +822,19 @@ class Spacetime {
     /// relevant to store that simplex by the orientation of any given face, so _internal_ simplices are stored by the
     /// orientation of the Simplex itself.
     std::unordered_map<SimplexOrientationPtr, SimplexSet, SimplexOrientationHash, SimplexOrientationEq> internalSimplices{};
+
+    /// \f$ N_k \f$ for k >= 2, indexed by k. The first two entries are unused. See `getFaceCount`.
+    std::vector<std::size_t> faceCounts{};
+
+    /// Simplices created through `createSimplex` or by a move, keyed by `SimplexOrientation::fingerprint`.
+    std::unordered_map<std::uint16_t, std::size_t> orientationCounts{};
+
+    /// Candidate sites for each move, by the IDs of their vertices. See `countMoveSites`.
+    std::array<SamplingIndex<SimplexFingerprint, SiteHash>, kNumMoveTypes> moveSites{};
+
+    /// The number of vertices of the top simplices `moveSites` was built from, or 0 if it hasn't been built.
+    std::size_t siteSimplexSize = 0;
+
     std::vector<std::shared_ptr<Observable> > observables{};
 };
 } // caset
@@ -0,0 +1,89 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+
+#include "Job.h"
+
+namespace caset {
+Job::Job(Work work) {
+  worker = std::thread([this, work = std::move(work)] {
+    std::exception_ptr thrown{};
+    try {
+      work(progress);
+    } catch (...) {
+      thrown = std::current_exception();
+    }
+    {
+      std::lock_guard lock(mutex);
+      error = thrown;
+      stopped = Clock::now();
+      done = true;
+    }
+    finished.notify_all();
+  });
+}
+
+Job::~Job() {
+  cancel();
+  if (worker.joinable()) worker.join();
+}
+
+bool Job::wait(const std::optional<double> timeout) {
+  std::unique_lock lock(mutex);
+  if (!timeout) {
+    finished.wait(lock, [this] { return done; });
+    return true;
+  }
+  return finished.wait_for(lock, std::chrono::duration<double>(std::max(*timeout, 0.)), [this] { return done; });
+}
+
+void Job::get() {
+  wait();
+  std::lock_guard lock(mutex);
+  if (error) std::rethrow_exception(error);
+}
+
+bool Job::isDone() const {
+  std::lock_guard lock(mutex);
+  return done;
+}
+
+Job::Snapshot Job::getProgress() const {
+  Snapshot snapshot{};
+  {
+    std::lock_guard lock(mutex);
+    snapshot.done = done;
+    snapshot.seconds = std::chrono::duration<double>((done ? stopped : Clock::now()) - started).count();
+  }
+  snapshot.glued = progress.glued.load(std::memory_order_relaxed);
+  snapshot.sweeps = progress.sweeps.load(std::memory_order_relaxed);
+  snapshot.attempts = progress.attempts.load(std::memory_order_relaxed);
+  snapshot.accepted = progress.accepted.load(std::memory_order_relaxed);
+  snapshot.cancelled = progress.isCancelled();
+  if (snapshot.seconds > 0.) {
+    snapshot.gluedPerSecond = static_cast<double>(snapshot.glued) / snapshot.seconds;
+    snapshot.sweepsPerSecond = static_cast<double>(snapshot.sweeps) / snapshot.seconds;
+    snapshot.attemptsPerSecond = static_cast<double>(snapshot.attempts) / snapshot.seconds;
+  }
+  return snapshot;
+}
+}
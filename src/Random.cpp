@@ -0,0 +1,78 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Random.h"
+
+#include <algorithm>
+
+namespace caset {
+namespace {
+/// Words drawn per batch in `fillUniform`.
+constexpr std::size_t kBatch = 256;
+}
+
+// Each iteration is one block, with the rounds unrolled into straight-line code and no dependencies between
+// iterations, so the compiler can run as many blocks side by side as the target's vector registers hold.
+void Philox::drawBlocks(const std::uint64_t first, const std::size_t count, std::uint64_t *__restrict out) const noexcept {
+  const std::uint64_t stream0 = low(stream), stream1 = high(stream);
+  const std::uint64_t seed0 = key[0], seed1 = key[1];
+  for (std::size_t i = 0; i < count; i++) {
+    // Lanes are 64 bits wide with the word in the low half, so the 32 x 32 -> 64 bit multiplies map directly onto
+    // the vector multiply instructions.
+    std::uint64_t c0 = low(first + i), c1 = high(first + i), c2 = stream0, c3 = stream1;
+    std::uint64_t key0 = seed0, key1 = seed1;
+#pragma GCC unroll 10
+    for (int round = 0; round < 10; round++) {
+      const std::uint64_t product0 = kMultiplier0 * c0;
+      const std::uint64_t product1 = kMultiplier1 * c2;
+      c0 = product1 >> 32 ^ c1 ^ key0;
+      c1 = low(product1);
+      c2 = product0 >> 32 ^ c3 ^ key1;
+      c3 = low(product0);
+      key0 = low(key0 + kWeyl0);
+      key1 = low(key1 + kWeyl1);
+    }
+    out[2 * i] = c1 << 32 | c0;
+    out[2 * i + 1] = c3 << 32 | c2;
+  }
+}
+
+void Philox::fillUniform(std::span<double> out) noexcept {
+  std::size_t i = 0;
+  // Finish the current block first, so the batch starts on a block boundary.
+  if ((words & 1) != 0 && i < out.size()) out[i++] = uniform();
+
+  alignas(64) std::uint64_t batch[kBatch];
+  while (out.size() - i >= 2) {
+    const std::size_t blocks = std::min(kBatch / 2, (out.size() - i) / 2);
+    drawBlocks(words / 2, blocks, batch);
+    for (std::size_t j = 0; j < 2 * blocks; j++) out[i + j] = toUnit(batch[j]);
+    words += 2 * blocks;
+    i += 2 * blocks;
+  }
+  if (i < out.size()) out[i] = uniform();
+}
+
+void Philox::fillExponential(std::span<double> out, const double rate) noexcept {
+  fillUniform(out);
+  for (double &value : out) value = -std::log(1. - value) / rate;
+}
+} // caset
@@ -22,11 +22,8 @@
 #include "Vertex.h"
 #include "Simplex.h"
 
-#include <ATen/core/interned_strings.h>
-#include <c10/util/ThreadLocalDebugInfo.h>
-
 namespace caset {
-std::vector<SimplexPtr > Simplex::getFacets() {
+const std::vector<SimplexPtr> &Simplex::getFacets() {
 #if CASET_DEBUG
   if (getVertices().empty()) throw std::runtime_error("Simplex is empty");
 #endif
@@ -34,10 +31,10 @@ std::vector<SimplexPtr > Simplex::getFacets() {
 #if CASET_DEBUG
     validate();
 #endif
-    return {};
+    return facets;
   }
   if (!facets.empty()) return facets;
-  auto verts = getVertices();
+  const auto &verts = getVertices();
   // facets.reserve(verts.size());
   for (int skip = 0; skip < verts.size(); skip++) {
     const auto &skipVertex = verts[skip]->getId();
@@ -50,7 +47,7 @@ std::vector<SimplexPtr > Simplex::getFacets() {
     for (const auto &e : getEdges()) {
       if (!e->hasVertex(skipVertex)) faceEdges.push_back(e);
     }
-    SimplexPtr facet = Simplex::create(faceVertices, faceEdges);
+    SimplexPtr facet = Simplex::create(faceVertices, faceEdges, getPool());
     facet->addCoface(shared_from_this());
     facets.push_back(facet);
   }
@@ -64,7 +61,7 @@ std::vector<SimplexPtr > Simplex::getFacets() {
 /// @param vertices_
 Simplex::Simplex(
   const Vertices &vertices_, Edges edges_
-) : orientation(std::make_shared<SimplexOrientation>(0, 0)), vertices(vertices_), edges(std::move(edges_)), fingerprint({}) {
+) : orientation(std::make_shared<SimplexOrientation>(0, 0)), vertices(vertices_), edges(std::move(edges_)), fingerprint() {
 #if CASET_DEBUG
   if (vertices_.empty()) throw std::runtime_error("Simplex is empty");
 #endif
@@ -73,29 +70,34 @@ Simplex::Simplex(
 }
 
 Simplex::Simplex(
-  const Vertices &vertices_, Edges edges_,
+  Vertices vertices_, Edges edges_,
   const SimplexOrientationPtr &orientation_
-) : orientation(orientation_), vertices(vertices_), edges(std::move(edges_)), fingerprint({}) {
+) : orientation(orientation_), vertices(std::move(vertices_)), edges(std::move(edges_)), fingerprint() {
 #if CASET_DEBUG
-  if (vertices_.empty()) throw std::runtime_error("Simplex is empty");
+  if (vertices.empty()) throw std::runtime_error("Simplex is empty");
 #endif
 }
 
-SimplexPtr Simplex::create(const Vertices &vertices_, const Edges &edges_) {
+SimplexPtr Simplex::create(const Vertices &vertices_, const Edges &edges_, Pool<Simplex> *pool) {
 #if CASET_DEBUG
   if (vertices_.empty()) throw std::runtime_error("Simplex is empty");
 #endif
-  SimplexPtr simplex = std::make_shared<Simplex>(vertices_, edges_);
+  SimplexPtr simplex = makePooled<Simplex>(pool, vertices_, edges_);
   simplex->initialize(simplex);
 
   return simplex;
 }
 
-SimplexPtr Simplex::create(const Vertices &vertices_, const Edges &edges_, const SimplexOrientationPtr &orientation_) {
+SimplexPtr Simplex::create(
+  const Vertices &vertices_,
+  const Edges &edges_,
+  const SimplexOrientationPtr &orientation_,
+  Pool<Simplex> *pool
+) {
 #if CASET_DEBUG
   if (vertices_.empty()) throw std::runtime_error("Simplex is empty");
 #endif
-  SimplexPtr simplex = std::make_shared<Simplex>(vertices_, edges_, orientation_);
+  SimplexPtr simplex = makePooled<Simplex>(pool, vertices_, edges_, orientation_);
   simplex->initialize(simplex);
   return simplex;
 }
@@ -109,7 +111,7 @@ void Simplex::initialize(const SimplexPtr &simplex) {
     vertexIdLookup.insert({v->getId(), v});
     v->addSimplex(simplex);
   }
-  fingerprint = Fingerprint(ids);
+  fingerprint = SimplexFingerprint(ids);
 #if CASET_DEBUG
   if (getVertexIdLookup().empty()) throw std::runtime_error("Simplex is empty");
 #endif
@@ -139,7 +141,7 @@ std::string Simplex::toString() const {
   return orientation;
 }
 
-[[nodiscard]] Vertices Simplex::getVertices() const noexcept { return vertices; };
+[[nodiscard]] const Vertices &Simplex::getVertices() const noexcept { return vertices; };
 
 [[nodiscard]] std::size_t Simplex::size() const noexcept {
   return vertices.size();
@@ -262,7 +264,7 @@ void Simplex::validate() const {
 }
 
 /// @returns Edges in traversal order (the order of input vertices).
-[[nodiscard]] Edges Simplex::getEdges() const {
+[[nodiscard]] const Edges &Simplex::getEdges() const noexcept {
   return edges;
 }
 
@@ -346,8 +348,11 @@ Simplex::getVerticesWithParityTo(const SimplexPtr &other) const {
 }
 
 [[nodiscard]] bool Simplex::hasEdge(const IdType vertexAId, const IdType vertexBId) const {
-  const EdgePtr edge = std::make_shared<Edge>(vertexAId, vertexBId);
-  return hasEdge(edge);
+  if (!hasVertex(vertexAId) || !hasVertex(vertexBId)) return false;
+  for (const auto &e : getEdges()) {
+    if (e->getSourceId() == vertexAId && e->getTargetId() == vertexBId) return true;
+  }
+  return false;
 }
 
 int8_t Simplex::checkParity(const SimplexPtr &other) const {
@@ -361,7 +366,7 @@ int8_t Simplex::checkParity(const SimplexPtr &other) const {
     positionByVertexIdInA[vertices[i]->getId()] = i;
   }
 
-  Vertices otherVertices = other->getVertices();
+  const Vertices &otherVertices = other->getVertices();
   std::vector<IdType> otherIds{};
   otherIds.reserve(K);
   for (int i = 0; i < K; ++i) {
@@ -401,7 +406,7 @@ int8_t Simplex::checkParity(const SimplexPtr &other) const {
   return transpositionsMod2 ? -1 : +1;
 }
 
-[[nodiscard]] SimplexSet
+[[nodiscard]] const SimplexSet &
 Simplex::getCofaces() const noexcept {
   return cofaces;
 }
@@ -422,6 +427,14 @@ bool Simplex::hasCausallyAvailableFacet() {
   return false;
 }
 
+std::optional<std::size_t> Simplex::findFacet(const SimplexPtr &face) {
+  const auto &facets_ = getFacets();
+  for (std::size_t i = 0; i < facets_.size(); i++) {
+    if (facets_[i]->fingerprint.fingerprint() == face->fingerprint.fingerprint()) return i;
+  }
+  return std::nullopt;
+}
+
 bool Simplex::isInternal() const noexcept {
   return getCofaces().size() == 2;
 }
@@ -447,7 +460,9 @@ bool Simplex::operator==(const SimplexPtr &other) const noexcept {
 /// This simplex is the unattached simplex.
 void Simplex::attach(const VertexPtr &unattached, const VertexPtr &attached, const std::shared_ptr<EdgeList> &edgeList, const std::shared_ptr<VertexList> &vertexList) {
   const auto [oldEdges, newEdges] = unattached->moveEdgesTo(attached, edgeList, vertexList);
-  for (const auto &simplex : unattached->getSimplices()) {
+  // replaceVertex removes each simplex from `unattached`, so walk a copy.
+  const Simplices simplices = unattached->getSimplices();
+  for (const auto &simplex : simplices) {
     simplex->replaceVertex(unattached, attached);
   }
   for (const auto &edgeKey : newEdges) {
@@ -497,7 +512,25 @@ bool Simplex::replaceVertex(const VertexPtr &oldVertex, const VertexPtr &newVert
   return true;
 }
 
-VertexIdMap Simplex::getVertexIdLookup() const noexcept {
+void Simplex::refreshVertexIds() {
+  std::vector<IdType> ids{};
+  ids.reserve(vertices.size());
+  vertexIdLookup.clear();
+  for (const auto &v : vertices) {
+    ids.push_back(v->getId());
+    vertexIdLookup.insert({v->getId(), v});
+  }
+  fingerprint.refreshFingerprint(ids);
+}
+
+void Simplex::rehashCofaces() {
+  SimplexSet rehashed{};
+  rehashed.reserve(cofaces.size());
+  for (const auto &coface : cofaces) rehashed.insert(coface);
+  cofaces = std::move(rehashed);
+}
+
+const VertexIdMap &Simplex::getVertexIdLookup() const noexcept {
   return vertexIdLookup;
 }
 
@@ -540,7 +573,7 @@ bool Simplex::cascade(Method method, bool up, bool down, Args &&... args) {
   }
 
   // --- Cascading to facets ---
-  auto facets_ = getFacets();
+  const auto &facets_ = getFacets();
   if (down && !facets_.empty()) {
     simplicesToUpdate.clear();
     simplicesToUpdate.insert(simplicesToUpdate.end(),
@@ -67,38 +67,75 @@ Vertex::moveTo(const std::shared_ptr<Vertex> &vertex)
   if (outEdges.empty()) {
     throw std::runtime_error("Cannot execute move; outEdges is empty!");
   }
-  std::shared_ptr<Edge> edge = std::make_shared<Edge>(getId(), vertex->getId());
-  if (!outEdges.contains(edge)) {
-    throw std::runtime_error("No edge to this vertex exists.");
+  const EdgeFingerprint fingerprint({getId(), vertex->getId()});
+  for (const auto &edge : outEdges) {
+    if (edge->fingerprint.fingerprint() == fingerprint.fingerprint()) return {edge, vertex};
   }
-  return std::pair<std::shared_ptr<Edge>, std::shared_ptr<Vertex> >({
-      *outEdges.find(edge), vertex
-  });
+  throw std::runtime_error("No edge to this vertex exists.");
 }
 
-std::unordered_set<std::shared_ptr<Edge>, EdgeHash, EdgeEq>
+std::vector<std::shared_ptr<Edge>>
 Vertex::getEdges() const noexcept {
-  std::unordered_set<std::shared_ptr<Edge>, EdgeHash, EdgeEq> edges;
+  std::vector<std::shared_ptr<Edge>> edges;
   edges.reserve(inEdges.size() + outEdges.size());
-  edges.insert(inEdges.begin(), inEdges.end());
-  edges.insert(outEdges.begin(), outEdges.end());
+  edges.insert(edges.end(), inEdges.begin(), inEdges.end());
+  edges.insert(edges.end(), outEdges.begin(), outEdges.end());
   return edges;
 }
 
 std::shared_ptr<Edge>
 Vertex::getEdge(const EdgeKey &key)
 {
-  const auto testEdge = std::make_shared<Edge>(key.first, key.second);
-  if (inEdges.contains(testEdge)) return *inEdges.find(testEdge);
-  if (outEdges.contains(testEdge)) return *outEdges.find(testEdge);
+  const EdgeFingerprint fingerprint({key.first, key.second});
+  for (const auto &edge : inEdges) {
+    if (edge->fingerprint.fingerprint() == fingerprint.fingerprint()) return edge;
+  }
+  for (const auto &edge : outEdges) {
+    if (edge->fingerprint.fingerprint() == fingerprint.fingerprint()) return edge;
+  }
   return nullptr;
 }
 
 std::shared_ptr<Edge> Vertex::getEdge(const EdgePtr &edge)
 {
-  if (inEdges.contains(edge)) return *inEdges.find(edge);
-  if (outEdges.contains(edge)) return *outEdges.find(edge);
-  return nullptr;
+  if (edge->targetSlot < inEdges.size() && inEdges[edge->targetSlot] == edge) return edge;
+  if (edge->sourceSlot < outEdges.size() && outEdges[edge->sourceSlot] == edge) return edge;
+  return getEdge(edge->getKey());
+}
+
+bool Vertex::insertEdge(Adjacency &adjacency, const std::shared_ptr<Edge> &edge, std::uint32_t Edge::*slot)
+{
+  const std::uint32_t index = (*edge).*slot;
+  if (index < adjacency.size() && adjacency[index] == edge) return false;
+#if CASET_DEBUG
+  for (const auto &e : adjacency) {
+    if (e->fingerprint.fingerprint() == edge->fingerprint.fingerprint()) {
+      CLOG(ERROR_LEVEL, "Edge ", edge->toString(), " is already stored as another Edge with the same key");
+      throw std::runtime_error("an equal Edge is already attached to this vertex");
+    }
+  }
+#endif
+  (*edge).*slot = static_cast<std::uint32_t>(adjacency.size());
+  adjacency.push_back(edge);
+  return true;
+}
+
+bool Vertex::eraseEdge(Adjacency &adjacency, const std::shared_ptr<Edge> &edge, std::uint32_t Edge::*slot) noexcept
+{
+  std::size_t index = (*edge).*slot;
+  if (index >= adjacency.size() || adjacency[index] != edge) {
+    // Either an equal Edge was stored in place of this one, or the slot belongs to a different list.
+    index = 0;
+    while (index < adjacency.size() && adjacency[index]->fingerprint.fingerprint() != edge->fingerprint.fingerprint()) {
+      index++;
+    }
+    if (index == adjacency.size()) return false;
+  }
+  // `edge` may alias the entry being removed, so don't touch it past this point.
+  (*adjacency[index]).*slot = std::numeric_limits<std::uint32_t>::max();
+  adjacency.swapRemove(index);
+  if (index < adjacency.size()) (*adjacency[index]).*slot = static_cast<std::uint32_t>(index);
+  return true;
 }
 
 std::pair<std::shared_ptr<EdgeIdSet>, std::shared_ptr<EdgeIdSet>>
@@ -109,7 +146,10 @@ Vertex::moveInEdgesTo(
   ) {
   std::shared_ptr<EdgeIdSet> oldEdges = std::make_shared<EdgeIdSet>();
   std::shared_ptr<EdgeIdSet> newEdges = std::make_shared<EdgeIdSet>();
-  for (const auto &edge : inEdges) {
+  // Detach the list first; `vertex` may be this Vertex.
+  const Adjacency moving = std::move(inEdges);
+  inEdges.clear();
+  for (const auto &edge : moving) {
     CLOG(DEBUG_LEVEL, "Moving in-edge ", edge->toString(), " to ", vertex->toString());
     oldEdges->insert(edge->getKey());
     edgeList->remove(edge);
@@ -121,7 +161,6 @@ Vertex::moveInEdgesTo(
     vertex->addInEdge(edgeList->add(edge));
     sourceVertex->addOutEdge(edgeList->get(edge->getKey()));
   }
-  inEdges.clear();
   return {oldEdges, newEdges};
 }
 
@@ -142,8 +181,9 @@ std::pair<std::shared_ptr<EdgeIdSet>, std::shared_ptr<EdgeIdSet>>
 Vertex::moveOutEdgesTo(const std::shared_ptr<Vertex> &vertex, const std::shared_ptr<EdgeList> &edgeList, const std::shared_ptr<VertexList> &vertexList) {
   std::shared_ptr<EdgeIdSet> oldEdges = std::make_shared<EdgeIdSet>();
   std::shared_ptr<EdgeIdSet> newEdges = std::make_shared<EdgeIdSet>();
-  std::unordered_set<std::shared_ptr<Edge>, EdgeHash, EdgeEq> newOutEdges{};
-  for (const auto &edge : outEdges) {
+  const Adjacency moving = std::move(outEdges);
+  outEdges.clear();
+  for (const auto &edge : moving) {
     CLOG(DEBUG_LEVEL, "Moving out-edge ", edge->toString(), " to ", vertex->toString());
     oldEdges->insert(edge->getKey());
     edgeList->remove(edge);
@@ -155,7 +195,6 @@ Vertex::moveOutEdgesTo(const std::shared_ptr<Vertex> &vertex, const std::shared_
     vertex->addOutEdge(edgeList->add(edge));
     targetVertex->addInEdge(edgeList->get(edge->getKey()));
   }
-  outEdges.clear();
   return {oldEdges, newEdges};
 }
 
@@ -184,7 +223,7 @@ void Vertex::removeSimplex(const std::shared_ptr<Simplex> &simplex) {
 #endif
 }
 
-std::vector<std::shared_ptr<Simplex>>
+const std::vector<std::shared_ptr<Simplex>> &
 Vertex::getSimplices() const noexcept
 {
   return simplices;
@@ -26,4 +26,43 @@
 #include "VertexList.h"
 
 namespace caset {
+std::vector<IdType> VertexList::compact() {
+  std::vector<IdType> remap = compactMapping();
+  std::size_t next = 0;
+  for (std::size_t i = 0; i < vertices.size(); i++) {
+    auto &vertex = vertices[i];
+    if (vertex == nullptr) continue;
+    vertex->id = remap[firstId + i];
+    if (next != i) vertices[next] = std::move(vertex);
+    next++;
+  }
+  vertices.resize(next);
+  vertices.shrink_to_fit();
+  return remap;
+}
+
+std::vector<IdType> VertexList::compactMapping() const {
+  std::vector<IdType> remap(idBound(), kRemoved);
+  std::size_t next = 0;
+  for (std::size_t i = 0; i < vertices.size(); i++) {
+    if (vertices[i] != nullptr) remap[firstId + i] = firstId + next++;
+  }
+  return remap;
+}
+
+void VertexList::absorb(VertexList &other) {
+  if (&other == this || other.live == 0) return;
+  if (other.idBound() > idBound()) vertices.reserve(other.idBound() - firstId);
+  for (auto &vertex : other.vertices) {
+    if (vertex == nullptr) continue;
+    auto &existing = slot(vertex->getId());
+    if (existing != nullptr) {
+      throw std::invalid_argument("VertexList: both lists hold vertex " + std::to_string(vertex->getId()));
+    }
+    existing = std::move(vertex);
+  }
+  other.vertices.clear();
+  other.live = 0;
+}
+
 } // caset
\ No newline at end of file
@@ -25,11 +25,17 @@
 #include <pybind11/complex.h>
 #include <pybind11/functional.h>
 #include <pybind11/chrono.h>
+#include <pybind11/numpy.h>
 
 #include "spacetime/topologies/Topology.h"
 #include "spacetime/topologies/Sphere.h"
 #include "spacetime/topologies/Toroid.h"
 #include "spacetime/Spacetime.h"
+#include "spacetime/ConfigurationLog.h"
+#include "simulations/CDT.h"
+#include "simulations/ParallelTempering.h"
+#include "simulations/EnsembleRunner.h"
+#include "observables/SpacetimeVolume.h"
 #include "VertexList.h"
 #include "EdgeList.h"
 #include "Signature.h"
@@ -37,22 +43,118 @@
 #include "Edge.h"
 #include "Simplex.h"
 #include "Metric.h"
+#include "Random.h"
+#include "Job.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace py = pybind11;
 
 using namespace caset;
 
+using Schedule = py::array_t<std::int64_t, py::array::c_style | py::array::forcecast>;
+
+/// Copies an (n, 2) array of (ti, tf) rows into the orientation list the build methods take, refusing any count
+/// outside 1..kMaxSimplexVertices rather than letting it wrap into a uint8_t.
+static std::vector<std::tuple<uint8_t, uint8_t> > toOrientations(const Schedule &schedule) {
+  if (schedule.ndim() != 2 || schedule.shape(1) != 2) {
+    throw std::invalid_argument("schedule must be an (n, 2) array of (ti, tf) orientations");
+  }
+  const auto rows = schedule.unchecked<2>();
+  std::vector<std::tuple<uint8_t, uint8_t> > orientations{};
+  orientations.reserve(rows.shape(0));
+  for (py::ssize_t i = 0; i < rows.shape(0); i++) {
+    for (py::ssize_t j = 0; j < 2; j++) {
+      if (rows(i, j) < 1 || rows(i, j) > static_cast<std::int64_t>(kMaxSimplexVertices)) {
+        throw std::invalid_argument("schedule row " + std::to_string(i) + " has " + std::to_string(rows(i, j)) +
+                                    " vertices on a slice; each must be between 1 and " +
+                                    std::to_string(kMaxSimplexVertices));
+      }
+    }
+    orientations.emplace_back(static_cast<uint8_t>(rows(i, 0)), static_cast<uint8_t>(rows(i, 1)));
+  }
+  return orientations;
+}
+
+/// Hands `values` to NumPy without copying them: the array's base object takes ownership of the vector.
+template<typename T>
+static py::array_t<T> toArray(std::vector<T> &&values, const std::vector<py::ssize_t> &shape) {
+  auto *owned = new std::vector<T>(std::move(values));
+  const py::capsule base(owned, [](void *vector) { delete static_cast<std::vector<T> *>(vector); });
+  return py::array_t<T>(shape, owned->data(), base);
+}
+
+/// Builds one of `Spacetime`'s arrays without the GIL and wraps it as `columns`-wide rows (a flat array for 0).
+template<typename T>
+static py::array_t<T> exportArray(const Spacetime &spacetime, std::vector<T> (Spacetime::*array)() const,
+                                  const std::size_t columns = 0) {
+  std::vector<T> values{};
+  {
+    py::gil_scoped_release release;
+    values = (spacetime.*array)();
+  }
+  const auto size = static_cast<py::ssize_t>(values.size());
+  if (columns == 0) return toArray(std::move(values), {size});
+  const auto width = static_cast<py::ssize_t>(columns);
+  return toArray(std::move(values), {size / width, width});
+}
+
 PYBIND11_MODULE(caset, m) {
+  py::class_<Philox>(m, "Philox")
+      .def(py::init<std::uint64_t, std::uint64_t>(), py::arg("seed"), py::arg("stream") = 0)
+      .def("seed", &Philox::seed, py::arg("seed"), py::arg("stream") = 0)
+      .def("split", &Philox::split, py::arg("stream"))
+      .def("getSeed", &Philox::getSeed)
+      .def("getStream", &Philox::getStream)
+      .def("getPosition", &Philox::getPosition)
+      .def("discard", &Philox::discard, py::arg("n"))
+      .def("__call__", [](Philox &rng) { return rng(); })
+      .def("below", &Philox::below, py::arg("n"))
+      .def("uniform",
+           [](Philox &rng, const py::ssize_t n) {
+             py::array_t<double> out(n);
+             rng.fillUniform({out.mutable_data(), static_cast<std::size_t>(n)});
+             return out;
+           },
+           py::arg("n"))
+      .def("exponential",
+           [](Philox &rng, const py::ssize_t n, const double rate) {
+             py::array_t<double> out(n);
+             rng.fillExponential({out.mutable_data(), static_cast<std::size_t>(n)}, rate);
+             return out;
+           },
+           py::arg("n"),
+           py::arg("rate") = 1.)
+      .def("normal",
+           [](Philox &rng, const py::ssize_t n) {
+             py::array_t<double> out(n);
+             double *values = out.mutable_data();
+             for (py::ssize_t i = 0; i < n; i++) values[i] = rng.normal();
+             return out;
+           },
+           py::arg("n"))
+      .def("__eq__", &Philox::operator==);
+
   py::class_<Edge, std::shared_ptr<Edge> >(m, "Edge")
+      .def(
+        py::init([](const std::uint64_t source, const std::uint64_t target) {
+          return std::make_shared<Edge>(source, target, 0.);
+        }),
+        py::arg("source"),
+        py::arg("target")
+      )
       .def(
         py::init<
           std::uint64_t,
-          std::uint64_t
-        >(),
+          std::uint64_t,
+          Philox &>(),
         py::arg("source"),
-        py::arg("target")
+        py::arg("target"),
+        py::arg("generator")
       )
       .def(
         py::init<
@@ -67,6 +169,7 @@ PYBIND11_MODULE(caset, m) {
       .def("__repr__", &Edge::toString)
       .def("__eq__", &Edge::operator==)
       .def("__hash__", &Edge::toHash)
+      .def("getHandle", [](const Edge &edge) { return edge.getHandle().raw(); })
       .def("getSourceId", &Edge::getSourceId)
       .def("getSquaredLength", &Edge::getSquaredLength)
       .def("redirect", &Edge::redirect)
@@ -83,9 +186,14 @@ PYBIND11_MODULE(caset, m) {
       .def("getCoordinates", &Vertex::getCoordinates)
       .def("setCoordinates", &Vertex::setCoordinates, py::arg("coordinates"))
       .def("getEdges", &Vertex::getEdges)
+      .def("getHandle", [](const Vertex &vertex) { return vertex.getHandle().raw(); })
       .def("getId", &Vertex::getId)
-      .def("getInEdges", &Vertex::getInEdges)
-      .def("getOutEdges", &Vertex::getOutEdges)
+      .def("getInEdges", [](const Vertex &vertex) {
+        return Edges(vertex.getInEdges().begin(), vertex.getInEdges().end());
+      })
+      .def("getOutEdges", [](const Vertex &vertex) {
+        return Edges(vertex.getOutEdges().begin(), vertex.getOutEdges().end());
+      })
       .def("removeInEdge", &Vertex::removeInEdge)
       .def("removeOutEdge", &Vertex::removeOutEdge)
       .def("moveEdgesTo", &Vertex::moveEdgesTo)
@@ -101,13 +209,16 @@ PYBIND11_MODULE(caset, m) {
       .def("add", py::overload_cast<const std::uint64_t>(&VertexList::add))
       .def("replace", &VertexList::replace)
       .def("size", &VertexList::size)
+      .def("contains", &VertexList::contains, py::arg("id"))
+      .def("idBound", &VertexList::idBound)
+      .def("tombstones", &VertexList::tombstones)
       .def("toVector", &VertexList::toVector);
 
   py::class_<EdgeList, std::shared_ptr<EdgeList> >(m, "EdgeList")
       .def(py::init<>())
       .def("add", py::overload_cast<const std::shared_ptr<Edge> &>(&EdgeList::add))
       .def("add", py::overload_cast<const std::uint64_t, const std::uint64_t, double>(&EdgeList::add))
-      .def("add", py::overload_cast<const std::uint64_t, const std::uint64_t>(&EdgeList::add))
+      .def("add", py::overload_cast<const std::uint64_t, const std::uint64_t, Philox &>(&EdgeList::add))
       .def("remove", py::overload_cast<const EdgeKey &>(&EdgeList::remove), py::arg("edgeKey"))
       .def("remove", py::overload_cast<const EdgePtr &>(&EdgeList::remove), py::arg("edge"))
       .def("size", &EdgeList::size)
@@ -147,8 +258,10 @@ PYBIND11_MODULE(caset, m) {
       .def("getCofaces", &Simplex::getCofaces)
       .def("getEdges", &Simplex::getEdges)
       .def("getFacets", &Simplex::getFacets)
+      .def("getHandle", [](const Simplex &simplex) { return simplex.getHandle().raw(); })
       .def("getNumberOfFaces", &Simplex::getNumberOfFaces)
       .def("getOrientation", &Simplex::getOrientation)
+      .def("getFreeFacets", &Simplex::getFreeFacets)
       .def("getVertexIdLookup", &Simplex::getVertexIdLookup)
       .def("getVertices", &Simplex::getVertices)
       .def("getVerticesWithPairtyTo", &Simplex::getVerticesWithParityTo, py::arg("other"))
@@ -179,6 +292,44 @@ PYBIND11_MODULE(caset, m) {
       .def(py::init<int, SignatureType>(), py::arg("dimensions"), py::arg("signature_type"))
       .def("getDiagonal", &Signature::getDiagonal);
 
+  py::class_<BuildStats>(m, "BuildStats")
+      .def_readonly("created", &BuildStats::created)
+      .def_readonly("glued", &BuildStats::glued)
+      .def_readonly("unmatched", &BuildStats::unmatched)
+      .def_readonly("rejected", &BuildStats::rejected)
+      .def_readonly("createSeconds", &BuildStats::createSeconds)
+      .def_readonly("chooseSeconds", &BuildStats::chooseSeconds)
+      .def_readonly("attachSeconds", &BuildStats::attachSeconds)
+      .def_readonly("mergeSeconds", &BuildStats::mergeSeconds);
+
+  py::class_<Job, std::shared_ptr<Job> > job(m, "Job");
+
+  py::class_<Job::Snapshot>(job, "Progress")
+      .def_readonly("glued", &Job::Snapshot::glued)
+      .def_readonly("sweeps", &Job::Snapshot::sweeps)
+      .def_readonly("attempts", &Job::Snapshot::attempts)
+      .def_readonly("accepted", &Job::Snapshot::accepted)
+      .def_readonly("seconds", &Job::Snapshot::seconds)
+      .def_readonly("gluedPerSecond", &Job::Snapshot::gluedPerSecond)
+      .def_readonly("sweepsPerSecond", &Job::Snapshot::sweepsPerSecond)
+      .def_readonly("attemptsPerSecond", &Job::Snapshot::attemptsPerSecond)
+      .def_readonly("done", &Job::Snapshot::done)
+      .def_readonly("cancelled", &Job::Snapshot::cancelled);
+
+  job.def("cancel", &Job::cancel)
+      .def("wait", &Job::wait, py::arg("timeout") = std::nullopt, py::call_guard<py::gil_scoped_release>())
+      .def("get", &Job::get, py::call_guard<py::gil_scoped_release>())
+      .def("isDone", &Job::isDone)
+      .def("isCancelled", &Job::isCancelled)
+      .def("getProgress", &Job::getProgress);
+
+  py::class_<EmbeddingStats>(m, "EmbeddingStats")
+      .def_readonly("iterations", &EmbeddingStats::iterations)
+      .def_readonly("stress", &EmbeddingStats::stress)
+      .def_readonly("seconds", &EmbeddingStats::seconds)
+      .def_readonly("vertices", &EmbeddingStats::vertices)
+      .def_readonly("converged", &EmbeddingStats::converged);
+
   py::class_<Spacetime, std::shared_ptr<Spacetime> >(m, "Spacetime")
       .def(py::init<
              std::shared_ptr<Metric>,
@@ -196,9 +347,124 @@ PYBIND11_MODULE(caset, m) {
       .def("getSimplicesWithOrientation", &Spacetime::getSimplicesWithOrientation, py::arg("orientation"))
       .def("getEdgeList", &Spacetime::getEdgeList)
       .def("getGluableFaces", &Spacetime::getGluableFaces)
-      .def("embedEuclidean", &Spacetime::embedEuclidean, py::arg("dimensions") = 4, py::arg("epsilon") = 1e-8)
-      .def("getConnectedComponents", &Spacetime::getConnectedComponents)
-      .def("build", &Spacetime::build)
+      .def("embedEuclidean",
+           &Spacetime::embedEuclidean,
+           py::arg("dimensions") = 4,
+           py::arg("epsilon") = 1e-8,
+           py::call_guard<py::gil_scoped_release>())
+      .def("embed",
+           [](Spacetime &spacetime, int dimensions, std::size_t maxIterations, double tolerance, double timeBudget,
+              std::size_t threads, double epsilon, double repulsion, double repulsionCutoff, bool incremental,
+              std::size_t hops, std::optional<std::uint64_t> seed) {
+             return spacetime.embed({dimensions, maxIterations, tolerance, timeBudget, threads, epsilon, repulsion,
+                                     repulsionCutoff, incremental, hops, seed});
+           },
+           py::arg("dimensions") = 4,
+           py::arg("maxIterations") = 1000,
+           py::arg("tolerance") = 1e-6,
+           py::arg("timeBudget") = 0.,
+           py::arg("threads") = 0,
+           py::arg("epsilon") = 1e-8,
+           py::arg("repulsion") = 0.,
+           py::arg("repulsionCutoff") = 1.,
+           py::arg("incremental") = false,
+           py::arg("hops") = 2,
+           py::arg("seed") = py::none(),
+           py::call_guard<py::gil_scoped_release>())
+      .def("getConnectedComponents", &Spacetime::getConnectedComponents, py::call_guard<py::gil_scoped_release>())
+      .def("getVertex",
+           [](const Spacetime &spacetime, std::uint64_t handle) { return spacetime.getVertex(Handle::fromRaw(handle)); },
+           py::arg("handle"))
+      .def("getEdge",
+           [](const Spacetime &spacetime, std::uint64_t handle) { return spacetime.getEdge(Handle::fromRaw(handle)); },
+           py::arg("handle"))
+      .def("getSimplex",
+           [](const Spacetime &spacetime, std::uint64_t handle) { return spacetime.getSimplex(Handle::fromRaw(handle)); },
+           py::arg("handle"))
+      .def("compact", &Spacetime::compact)
+      .def("clone", &Spacetime::clone, py::call_guard<py::gil_scoped_release>())
+      .def("save", &Spacetime::save, py::arg("path"), py::call_guard<py::gil_scoped_release>())
+      .def_static("load", &Spacetime::load, py::arg("path"), py::arg("topology") = std::nullopt,
+                  py::call_guard<py::gil_scoped_release>())
+      .def_static("fromArrays",
+                  [](const py::array_t<double, py::array::c_style | py::array::forcecast> &times,
+                     const py::array_t<std::int64_t, py::array::c_style | py::array::forcecast> &simplices,
+                     const std::optional<py::array_t<double, py::array::c_style | py::array::forcecast> > &lengths) {
+                    if (times.ndim() != 1) throw std::invalid_argument("times must be a 1-d array");
+                    if (simplices.ndim() != 2) throw std::invalid_argument("simplices must be an (n, k) array");
+                    const std::span<const double> squaredLengths = lengths.has_value()
+                      ? std::span<const double>(lengths->data(), static_cast<std::size_t>(lengths->size()))
+                      : std::span<const double>();
+                    py::gil_scoped_release release;
+                    return Spacetime::fromArrays({times.data(), static_cast<std::size_t>(times.size())},
+                                                 {simplices.data(), static_cast<std::size_t>(simplices.size())},
+                                                 static_cast<std::size_t>(simplices.shape(1)), squaredLengths);
+                  },
+                  py::arg("times"),
+                  py::arg("simplices"),
+                  py::arg("squaredLengths") = std::nullopt)
+      .def("seed", &Spacetime::seed, py::arg("value"), py::arg("stream") = 0)
+      .def("getFaceCount", &Spacetime::getFaceCount, py::arg("k"))
+      .def("getFVector", &Spacetime::getFVector)
+      .def("getVertexIdArray",
+           [](const Spacetime &spacetime) { return exportArray(spacetime, &Spacetime::getVertexIdArray); })
+      .def("getTimeArray", [](const Spacetime &spacetime) { return exportArray(spacetime, &Spacetime::getTimeArray); })
+      .def("getCoordinateArray",
+           [](const Spacetime &spacetime) {
+             return exportArray(spacetime, &Spacetime::getCoordinateArray, spacetime.getCoordinateWidth());
+           })
+      .def("getEdgeArray",
+           [](const Spacetime &spacetime) { return exportArray(spacetime, &Spacetime::getEdgeArray, 2); })
+      .def("getSquaredLengthArray",
+           [](const Spacetime &spacetime) { return exportArray(spacetime, &Spacetime::getSquaredLengthArray); })
+      .def("getSimplexArray",
+           [](const Spacetime &spacetime) {
+             return exportArray(spacetime, &Spacetime::getSimplexArray, spacetime.getDimension() + 1);
+           })
+      .def("getLayoutDimensions", &Spacetime::getLayoutDimensions)
+      .def("getLayoutArray",
+           [](const Spacetime &spacetime) {
+             return exportArray(spacetime, &Spacetime::getLayoutArray, spacetime.getLayoutDimensions());
+           })
+      .def("getSimplexCount", &Spacetime::getSimplexCount, py::arg("orientation"))
+      .def("getEulerCharacteristic", &Spacetime::getEulerCharacteristic)
+      .def("action", &Spacetime::action, py::arg("kappa0"), py::arg("delta"), py::arg("kappa4"))
+      .def("reserve", &Spacetime::reserve, py::arg("vertices"), py::arg("edges"), py::arg("simplices"))
+      .def("build", &Spacetime::build, py::arg("numSimplices") = 3, py::call_guard<py::gil_scoped_release>())
+      .def("buildBulk",
+           [](Spacetime &spacetime, const Schedule &schedule) {
+             const auto orientations = toOrientations(schedule);
+             py::gil_scoped_release release;
+             return spacetime.buildBulk(orientations);
+           },
+           py::arg("schedule"))
+      .def("buildSlabs",
+           [](Spacetime &spacetime, const Schedule &schedule, std::size_t slabs, std::size_t threads) {
+             const auto orientations = toOrientations(schedule);
+             py::gil_scoped_release release;
+             return spacetime.buildSlabs(orientations, slabs, threads);
+           },
+           py::arg("schedule"),
+           py::arg("slabs"),
+           py::arg("threads") = 0)
+      .def("buildBulkAsync",
+           [](const std::shared_ptr<Spacetime> &spacetime, const Schedule &schedule) {
+             return std::make_shared<Job>([spacetime, orientations = toOrientations(schedule)](Progress &progress) {
+               spacetime->buildBulk(orientations, &progress);
+             });
+           },
+           py::arg("schedule"))
+      .def("buildSlabsAsync",
+           [](const std::shared_ptr<Spacetime> &spacetime, const Schedule &schedule, std::size_t slabs,
+              std::size_t threads) {
+             return std::make_shared<Job>(
+               [spacetime, orientations = toOrientations(schedule), slabs, threads](Progress &progress) {
+                 spacetime->buildSlabs(orientations, slabs, threads, &progress);
+               });
+           },
+           py::arg("schedule"),
+           py::arg("slabs"),
+           py::arg("threads") = 0)
       .def("getSimplices", &Spacetime::getExternalSimplices)
       .def("chooseSimplexFacesToGlue", &Spacetime::chooseSimplexFacesToGlue, py::arg("simplex"))
       .def("createVertex",
@@ -233,7 +499,197 @@ PYBIND11_MODULE(caset, m) {
       .def("attachAtVertices", &Spacetime::attachAtVertices, py::arg("simplex"), py::arg("vertexA"), py::arg("vertexB"))
       .def("moveInEdgesFromVertex", &Spacetime::moveInEdgesFromVertex, py::arg("fromVertex"), py::arg("toVertex"))
       .def("moveOutEdgesFromVertex", &Spacetime::moveOutEdgesFromVertex, py::arg("fromVertex"), py::arg("toVertex"))
-      .def("causallyAttachFaces", &Spacetime::causallyAttachFaces);
+      .def("causallyAttachFaces", &Spacetime::causallyAttachFaces)
+      .def("insertVertex", &Spacetime::insertVertex, py::arg("face"))
+      .def("removeVertex", &Spacetime::removeVertex, py::arg("vertex"))
+      .def("flipSpatialFace", &Spacetime::flipSpatialFace, py::arg("face"))
+      .def("flipTimelikeFace", &Spacetime::flipTimelikeFace, py::arg("face"))
+      .def("countMoveSites", &Spacetime::countMoveSites, py::arg("move"))
+      .def("sampleMoveSite", &Spacetime::sampleMoveSite, py::arg("move"), py::arg("generator"));
+
+  py::class_<CDT::MoveStats>(m, "MoveStats")
+      .def_readonly("attempted", &CDT::MoveStats::attempted)
+      .def_readonly("accepted", &CDT::MoveStats::accepted)
+      .def_readonly("seconds", &CDT::MoveStats::seconds)
+      .def("attemptedPerSecond", &CDT::MoveStats::attemptedPerSecond)
+      .def("acceptedPerSecond", &CDT::MoveStats::acceptedPerSecond);
+
+  py::class_<CDT, std::shared_ptr<CDT> > cdt(m, "CDT");
+
+  py::enum_<CDT::Move>(cdt, "Move")
+      .value("Add", CDT::Move::Add)
+      .value("Remove", CDT::Move::Remove)
+      .value("Flip", CDT::Move::Flip)
+      .value("Shift", CDT::Move::Shift)
+      .value("Ishift", CDT::Move::Ishift);
+
+  py::class_<CDT::Couplings>(cdt, "Couplings")
+      .def(py::init([](double kappa0, double delta, double kappa4) { return CDT::Couplings{kappa0, delta, kappa4}; }),
+           py::arg("kappa0") = 0.,
+           py::arg("delta") = 0.,
+           py::arg("kappa4") = 0.)
+      .def_readwrite("kappa0", &CDT::Couplings::kappa0)
+      .def_readwrite("delta", &CDT::Couplings::delta)
+      .def_readwrite("kappa4", &CDT::Couplings::kappa4);
+
+  cdt.def(py::init<std::shared_ptr<Spacetime> >(), py::arg("spacetime"))
+      .def("add", &CDT::add)
+      .def("remove", &CDT::remove)
+      .def("flip", &CDT::flip)
+      .def("shift", &CDT::shift)
+      .def("ishift", &CDT::ishift)
+      .def("attempt", &CDT::attempt, py::arg("move"))
+      .def("sweep", &CDT::sweep, py::arg("attempts"), py::call_guard<py::gil_scoped_release>())
+      .def("run",
+           [](CDT &chain, std::size_t sweeps, std::size_t attempts) { return chain.run(sweeps, attempts); },
+           py::arg("sweeps"),
+           py::arg("attempts"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("runAsync",
+           [](const std::shared_ptr<CDT> &chain, std::size_t sweeps, std::size_t attempts) {
+             return std::make_shared<Job>([=](Progress &progress) { chain->run(sweeps, attempts, &progress); });
+           },
+           py::arg("sweeps"),
+           py::arg("attempts"))
+      .def("proposalProbability", &CDT::proposalProbability, py::arg("move"))
+      .def("acceptanceRatio", &CDT::acceptanceRatio, py::arg("move"), py::arg("site"))
+      .def("getStats", &CDT::getStats, py::arg("move"))
+      .def("resetStats", &CDT::resetStats)
+      .def("seed", &CDT::seed, py::arg("value"), py::arg("stream") = 0)
+      .def("setCouplings", &CDT::setCouplings, py::arg("value"))
+      .def("getCouplings", &CDT::getCouplings)
+      .def("action", &CDT::action, py::arg("at"))
+      .def("getSpacetime", &CDT::getSpacetime);
+
+  py::class_<ParallelTempering, std::shared_ptr<ParallelTempering> > tempering(m, "ParallelTempering");
+
+  py::class_<ParallelTempering::SwapStats>(tempering, "SwapStats")
+      .def_readonly("attempted", &ParallelTempering::SwapStats::attempted)
+      .def_readonly("accepted", &ParallelTempering::SwapStats::accepted)
+      .def("acceptance", &ParallelTempering::SwapStats::acceptance);
+
+  py::class_<ParallelTempering::RoundTripStats>(tempering, "RoundTripStats")
+      .def_readonly("completed", &ParallelTempering::RoundTripStats::completed)
+      .def_readonly("meanRounds", &ParallelTempering::RoundTripStats::meanRounds);
+
+  tempering.def(py::init<const std::vector<std::shared_ptr<Spacetime> > &, std::vector<CDT::Couplings> >(),
+                py::arg("replicas"),
+                py::arg("ladder"))
+      .def("run",
+           &ParallelTempering::run,
+           py::arg("rounds"),
+           py::arg("attempts"),
+           py::arg("threads") = 0,
+           py::call_guard<py::gil_scoped_release>())
+      .def("exchange", &ParallelTempering::exchange)
+      .def("seed", &ParallelTempering::seed, py::arg("value"))
+      .def("size", &ParallelTempering::size)
+      .def("getLadder", &ParallelTempering::getLadder)
+      .def("getReplicaAt", &ParallelTempering::getReplicaAt, py::arg("rung"))
+      .def("getRung", &ParallelTempering::getRung, py::arg("replica"))
+      .def("getSwapStats", &ParallelTempering::getSwapStats, py::arg("rung"))
+      .def("getRoundTripStats", &ParallelTempering::getRoundTripStats)
+      .def("getRounds", &ParallelTempering::getRounds);
+
+  py::class_<Observable, std::shared_ptr<Observable> >(m, "Observable")
+      .def("compute", &Observable::compute, py::arg("spacetime"))
+      .def("update", &Observable::update, py::arg("spacetime"));
+
+  py::class_<SpacetimeVolume, Observable, std::shared_ptr<SpacetimeVolume> >(m, "SpacetimeVolume")
+      .def(py::init<>());
+
+  py::class_<ConfigurationLog, std::shared_ptr<ConfigurationLog> >(m, "ConfigurationLog")
+      .def(py::init<const std::string &, std::size_t, std::size_t>(),
+           py::arg("path"),
+           py::arg("queueDepth") = 64,
+           py::arg("chunkBytes") = 1 << 20)
+      .def("append",
+           &ConfigurationLog::append,
+           py::arg("spacetime"),
+           py::arg("sweep"),
+           py::arg("chain") = 0,
+           py::call_guard<py::gil_scoped_release>())
+      .def("flush", &ConfigurationLog::flush, py::call_guard<py::gil_scoped_release>())
+      .def("close", &ConfigurationLog::close, py::call_guard<py::gil_scoped_release>())
+      .def("size", &ConfigurationLog::size)
+      .def("__len__", &ConfigurationLog::size);
+
+  py::class_<ConfigurationReader> reader(m, "ConfigurationReader");
+
+  py::class_<ConfigurationReader::Frame>(reader, "Frame")
+      .def_readonly("sweep", &ConfigurationReader::Frame::sweep)
+      .def_readonly("chain", &ConfigurationReader::Frame::chain)
+      .def_readonly("width", &ConfigurationReader::Frame::width)
+      .def_property_readonly("vertices",
+                             [](const ConfigurationReader::Frame &frame) {
+                               const auto width = static_cast<py::ssize_t>(frame.width);
+                               const auto simplices = static_cast<py::ssize_t>(frame.vertices.size()) / width;
+                               py::array_t<IdType> rows({simplices, width});
+                               std::copy(frame.vertices.begin(), frame.vertices.end(), rows.mutable_data());
+                               return rows;
+                             })
+      .def_property_readonly("orientations",
+                             [](const ConfigurationReader::Frame &frame) {
+                               py::array_t<std::uint8_t> rows({static_cast<py::ssize_t>(frame.orientations.size()) / 2,
+                                                               py::ssize_t{2}});
+                               std::copy(frame.orientations.begin(), frame.orientations.end(), rows.mutable_data());
+                               return rows;
+                             });
+
+  reader.def(py::init<const std::string &>(), py::arg("path"))
+      .def("getFrame", &ConfigurationReader::getFrame, py::arg("i"))
+      .def("getSweep", &ConfigurationReader::getSweep, py::arg("i"))
+      .def("getChain", &ConfigurationReader::getChain, py::arg("i"))
+      .def("isComplete", &ConfigurationReader::isComplete)
+      .def("size", &ConfigurationReader::size)
+      .def("__len__", &ConfigurationReader::size);
+
+  py::class_<EnsembleRunner, std::shared_ptr<EnsembleRunner> > ensemble(m, "EnsembleRunner");
+
+  py::class_<EnsembleRunner::Summary>(ensemble, "Summary")
+      .def_readonly("samples", &EnsembleRunner::Summary::samples)
+      .def_readonly("mean", &EnsembleRunner::Summary::mean)
+      .def_readonly("variance", &EnsembleRunner::Summary::variance);
+
+  ensemble.def(py::init<const std::vector<std::shared_ptr<Spacetime> > &, std::size_t, bool>(),
+               py::arg("spacetimes"),
+               py::arg("threads") = 0,
+               py::arg("pin") = true)
+      .def("setCouplings", &EnsembleRunner::setCouplings, py::arg("couplings"))
+      .def("addObservable", &EnsembleRunner::addObservable, py::arg("observable"))
+      .def("setConfigurationLog", &EnsembleRunner::setConfigurationLog, py::arg("log"), py::arg("every"))
+      .def("seed", &EnsembleRunner::seed, py::arg("value"))
+      .def("run",
+           [](EnsembleRunner &runner, std::size_t sweeps, std::size_t attempts, std::size_t measureEvery) {
+             runner.run(sweeps, attempts, measureEvery);
+           },
+           py::arg("sweeps"),
+           py::arg("attempts"),
+           py::arg("measureEvery") = 1,
+           py::call_guard<py::gil_scoped_release>())
+      .def("runAsync",
+           [](const std::shared_ptr<EnsembleRunner> &runner, std::size_t sweeps, std::size_t attempts,
+              std::size_t measureEvery) {
+             return std::make_shared<Job>([=](Progress &progress) {
+               runner->run(sweeps, attempts, measureEvery, &progress);
+             });
+           },
+           py::arg("sweeps"),
+           py::arg("attempts"),
+           py::arg("measureEvery") = 1)
+      .def("getSamples",
+           [](const EnsembleRunner &runner) {
+             std::vector<double> samples = runner.getSamples();
+             const auto width = static_cast<py::ssize_t>(runner.getSampleWidth());
+             const auto rows = static_cast<py::ssize_t>(samples.size()) / width;
+             return toArray(std::move(samples), {rows, width});
+           })
+      .def("summarize", &EnsembleRunner::summarize)
+      .def("clearSamples", &EnsembleRunner::clearSamples)
+      .def("getSampleWidth", &EnsembleRunner::getSampleWidth)
+      .def("size", &EnsembleRunner::size)
+      .def("getThreads", &EnsembleRunner::getThreads)
+      .def("getChain", &EnsembleRunner::getChain, py::arg("chain"));
 
   m.doc() = "A C++ library for simulating lattice spacetime and causal sets";
 }
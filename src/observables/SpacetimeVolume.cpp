@@ -19,4 +19,16 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include "observables/SpacetimeVolume.h"
\ No newline at end of file
+#include "observables/SpacetimeVolume.h"
+#include "spacetime/Spacetime.h"
+
+namespace caset {
+double SpacetimeVolume::compute(std::shared_ptr<Spacetime> &spacetime) {
+  return static_cast<double>(spacetime->getFaceCount(spacetime->getDimension()));
+}
+
+// The Spacetime keeps its face counts up to date, so there is nothing more to do incrementally.
+double SpacetimeVolume::update(std::shared_ptr<Spacetime> &spacetime) {
+  return compute(spacetime);
+}
+}
@@ -0,0 +1,120 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "simulations/CDT.h"
+
+namespace caset {
+namespace {
+constexpr std::array kPlanarMoves{CDT::Move::Add, CDT::Move::Remove, CDT::Move::Shift};
+constexpr std::array kAllMoves{CDT::Move::Add, CDT::Move::Remove, CDT::Move::Flip, CDT::Move::Shift, CDT::Move::Ishift};
+
+/// The move type that undoes `move` at a site of `size` vertices.
+CDT::Move inverseOf(const CDT::Move move, const std::size_t size) {
+  switch (move) {
+    case CDT::Move::Add: return CDT::Move::Remove;
+    case CDT::Move::Remove: return CDT::Move::Add;
+    case CDT::Move::Flip: return CDT::Move::Flip;
+    case CDT::Move::Shift:
+    case CDT::Move::Ishift: break;
+  }
+  // A timelike flip at k vertices leaves a site of d + 2 - k vertices, which is a facet when k = 2.
+  return size == 2 ? CDT::Move::Shift : CDT::Move::Ishift;
+}
+}
+
+bool CDT::attempt(const Move move) {
+  const auto start = std::chrono::steady_clock::now();
+  const bool accepted = propose(move);
+  auto &moveStats = stats[static_cast<std::size_t>(move)];
+  moveStats.attempted++;
+  if (accepted) moveStats.accepted++;
+  moveStats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return accepted;
+}
+
+std::size_t CDT::sweep(const std::size_t attempts) {
+  const std::span<const Move> moves = availableMoves();
+  std::size_t accepted = 0;
+  for (std::size_t i = 0; i < attempts; i++) {
+    if (attempt(moves[rng.below(moves.size())])) accepted++;
+  }
+  return accepted;
+}
+
+std::size_t CDT::run(const std::size_t sweeps, const std::size_t attempts, Progress *progress) {
+  std::size_t accepted = 0;
+  for (std::size_t i = 0; i < sweeps; i++) {
+    if (progress != nullptr && progress->isCancelled()) break;
+    const std::size_t made = sweep(attempts);
+    accepted += made;
+    if (progress == nullptr) continue;
+    progress->attempts.fetch_add(attempts, std::memory_order_relaxed);
+    progress->accepted.fetch_add(made, std::memory_order_relaxed);
+    progress->sweeps.fetch_add(1, std::memory_order_relaxed);
+  }
+  return accepted;
+}
+
+double CDT::proposalProbability(const Move move) {
+  const std::span<const Move> moves = availableMoves();
+  if (std::ranges::find(moves, move) == moves.end()) return 0.;
+  const std::size_t sites = spacetime->countMoveSites(move);
+  return sites == 0 ? 0. : 1. / static_cast<double>(moves.size() * sites);
+}
+
+std::span<const CDT::Move> CDT::availableMoves() const noexcept {
+  if (spacetime->getDimension() <= 2) return kPlanarMoves;
+  return kAllMoves;
+}
+
+bool CDT::propose(const Move move) {
+  const std::optional<Vertices> site = spacetime->sampleMoveSite(move, rng);
+  if (!site) return false;
+  if (couplings && !metropolis(move, *site)) return false;
+  switch (move) {
+    case Move::Add: return spacetime->insertVertex(*site) != nullptr;
+    case Move::Remove: return spacetime->removeVertex(site->front());
+    case Move::Flip: return spacetime->flipSpatialFace(*site);
+    case Move::Shift:
+    case Move::Ishift: return spacetime->flipTimelikeFace(*site);
+  }
+  return false;
+}
+
+double CDT::acceptanceRatio(const Move move, const Vertices &site) {
+  if (!couplings) return 1.;
+  const CountChange change = spacetime->countChange(move, site);
+  const auto &[kappa0, delta, kappa4] = *couplings;
+  const auto forward = static_cast<double>(spacetime->countMoveSites(move));
+  const auto backward = static_cast<double>(spacetime->countMoveSites(inverseOf(move, site.size()))) +
+                        static_cast<double>(change.inverseSites);
+  return forward / backward * std::exp(-Spacetime::actionChange(change, kappa0, delta, kappa4));
+}
+
+bool CDT::metropolis(const Move move, const Vertices &site) {
+  const double ratio = acceptanceRatio(move, site);
+  return ratio >= 1. || rng.uniform() < ratio;
+}
+}
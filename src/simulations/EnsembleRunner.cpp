@@ -0,0 +1,188 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "simulations/EnsembleRunner.h"
+
+namespace caset {
+namespace {
+/// Pins `thread` to the `worker`-th CPU this process may run on, where the platform allows it.
+void pinToCpu(std::thread &thread, const std::size_t worker) {
+#if defined(__linux__)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+  std::vector<int> cpus{};
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+  }
+  if (cpus.empty()) return;
+  cpu_set_t one;
+  CPU_ZERO(&one);
+  CPU_SET(cpus[worker % cpus.size()], &one);
+  // Pinning is only a hint for locality; a worker that can't be pinned still runs.
+  pthread_setaffinity_np(thread.native_handle(), sizeof(one), &one);
+#else
+  (void) thread;
+  (void) worker;
+#endif
+}
+}
+
+EnsembleRunner::EnsembleRunner(const std::vector<std::shared_ptr<Spacetime> > &spacetimes, std::size_t threads,
+                               const bool pin_) : pin(pin_) {
+  if (spacetimes.empty()) throw std::invalid_argument("an ensemble needs at least one chain");
+  chains.reserve(spacetimes.size());
+  for (std::size_t i = 0; i < spacetimes.size(); i++) {
+    if (!spacetimes[i]) throw std::invalid_argument("chain " + std::to_string(i) + " has no Spacetime");
+    for (std::size_t j = 0; j < i; j++) {
+      if (spacetimes[j] == spacetimes[i]) {
+        throw std::invalid_argument("chains " + std::to_string(j) + " and " + std::to_string(i) +
+                                    " share a Spacetime; clone it instead");
+      }
+    }
+    chains.push_back(std::make_shared<CDT>(spacetimes[i]));
+  }
+  sweepsDone.resize(chains.size(), 0);
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, chains.size());
+  for (std::size_t i = 0; i < threads; i++) buffers.push_back(std::make_unique<SampleBuffer>(getSampleWidth()));
+}
+
+void EnsembleRunner::setCouplings(const CDT::Couplings &couplings) {
+  for (const auto &chain : chains) chain->setCouplings(couplings);
+}
+
+void EnsembleRunner::addObservable(const std::shared_ptr<Observable> &observable) {
+  if (!observable) throw std::invalid_argument("observable is null");
+  for (const auto &buffer : buffers) {
+    if (buffer->size() != 0) throw std::logic_error("observables can't be added once samples have been recorded");
+  }
+  observables.push_back(observable);
+  for (auto &buffer : buffers) buffer = std::make_unique<SampleBuffer>(getSampleWidth());
+}
+
+void EnsembleRunner::setConfigurationLog(std::shared_ptr<ConfigurationLog> log_, const std::size_t every) {
+  log = std::move(log_);
+  logEvery = every;
+}
+
+void EnsembleRunner::seed(const std::uint64_t value) {
+  for (std::size_t i = 0; i < chains.size(); i++) chains[i]->seed(value, i);
+}
+
+void EnsembleRunner::run(const std::size_t sweeps, const std::size_t attempts, const std::size_t measureEvery,
+                         Progress *progress) {
+  std::vector<std::exception_ptr> errors(buffers.size());
+  std::vector<std::thread> workers{};
+  workers.reserve(buffers.size());
+  for (std::size_t worker = 0; worker < buffers.size(); worker++) {
+    workers.emplace_back([&, worker] {
+      try {
+        work(worker, sweeps, attempts, measureEvery, progress);
+      } catch (...) {
+        errors[worker] = std::current_exception();
+      }
+    });
+    if (pin) pinToCpu(workers.back(), worker);
+  }
+  for (auto &worker : workers) worker.join();
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+void EnsembleRunner::work(const std::size_t worker, const std::size_t sweeps, const std::size_t attempts,
+                          const std::size_t measureEvery, Progress *progress) {
+  SampleBuffer &buffer = *buffers[worker];
+  std::vector<double> row(getSampleWidth());
+  for (std::size_t chain = worker; chain < chains.size(); chain += buffers.size()) {
+    CDT &cdt = *chains[chain];
+    std::shared_ptr<Spacetime> spacetime = cdt.getSpacetime();
+    for (std::size_t sweep = 0; sweep < sweeps; sweep++) {
+      if (progress != nullptr && progress->isCancelled()) return;
+      const std::size_t made = cdt.sweep(attempts);
+      sweepsDone[chain]++;
+      if (progress != nullptr) {
+        progress->attempts.fetch_add(attempts, std::memory_order_relaxed);
+        progress->accepted.fetch_add(made, std::memory_order_relaxed);
+        progress->sweeps.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (log && logEvery != 0 && sweepsDone[chain] % logEvery == 0) {
+        log->append(*spacetime, sweepsDone[chain], static_cast<std::uint32_t>(chain));
+      }
+      if (measureEvery == 0 || sweepsDone[chain] % measureEvery != 0) continue;
+      row[0] = static_cast<double>(chain);
+      row[1] = static_cast<double>(sweepsDone[chain]);
+      for (std::size_t i = 0; i < observables.size(); i++) row[2 + i] = observables[i]->update(spacetime);
+      buffer.append(row);
+    }
+  }
+}
+
+std::vector<double> EnsembleRunner::getSamples() const {
+  const std::size_t width = getSampleWidth();
+  std::vector<const double *> rows{};
+  for (const auto &buffer : buffers) buffer->forEach([&](std::span<const double> row) { rows.push_back(row.data()); });
+  std::ranges::sort(rows, [](const double *a, const double *b) { return a[0] != b[0] ? a[0] < b[0] : a[1] < b[1]; });
+  std::vector<double> samples{};
+  samples.reserve(rows.size() * width);
+  for (const double *row : rows) samples.insert(samples.end(), row, row + width);
+  return samples;
+}
+
+EnsembleRunner::Summary EnsembleRunner::summarize() const {
+  Summary summary{};
+  summary.mean.assign(observables.size(), 0.);
+  summary.variance.assign(observables.size(), 0.);
+  // Welford's update, so the merge is one pass and doesn't lose precision on long runs.
+  for (const auto &buffer : buffers) {
+    buffer->forEach([&](std::span<const double> row) {
+      summary.samples++;
+      const auto n = static_cast<double>(summary.samples);
+      for (std::size_t i = 0; i < observables.size(); i++) {
+        const double delta = row[2 + i] - summary.mean[i];
+        summary.mean[i] += delta / n;
+        summary.variance[i] += delta * (row[2 + i] - summary.mean[i]);
+      }
+    });
+  }
+  for (auto &variance : summary.variance) {
+    variance = summary.samples > 1 ? variance / static_cast<double>(summary.samples - 1) : 0.;
+  }
+  return summary;
+}
+
+void EnsembleRunner::clearSamples() {
+  for (const auto &buffer : buffers) buffer->clear();
+}
+}
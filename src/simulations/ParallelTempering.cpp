@@ -0,0 +1,149 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "simulations/ParallelTempering.h"
+
+namespace caset {
+ParallelTempering::ParallelTempering(const std::vector<std::shared_ptr<Spacetime> > &replicas_,
+                                     std::vector<CDT::Couplings> ladder_) : ladder(std::move(ladder_)) {
+  if (replicas_.empty() || replicas_.size() != ladder.size()) {
+    throw std::invalid_argument("need one replica per rung, got " + std::to_string(replicas_.size()) +
+                                " replicas for " + std::to_string(ladder.size()) + " rungs");
+  }
+  const std::size_t size = ladder.size();
+  replicas.reserve(size);
+  for (std::size_t i = 0; i < size; i++) {
+    if (!replicas_[i]) throw std::invalid_argument("replica " + std::to_string(i) + " is null");
+    replicas.push_back(std::make_shared<CDT>(replicas_[i]));
+    replicas.back()->setCouplings(ladder[i]);
+    replicaAt.push_back(i);
+    rungOf.push_back(i);
+  }
+  swaps.resize(size - 1);
+  headings.resize(size, Heading::Unknown);
+  departures.resize(size, 0);
+  trackRoundTrips();
+}
+
+std::size_t ParallelTempering::run(const std::size_t rounds_, const std::size_t attempts, std::size_t threads) {
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, replicas.size());
+  std::size_t accepted = 0;
+  std::size_t round = 0;
+  std::vector<std::exception_ptr> errors(replicas.size());
+  std::exception_ptr error{};
+  std::atomic<std::size_t> next{0};
+
+  // Runs on one thread between rounds, once every worker has finished its sweeps. The workers stay alive for the whole
+  // run and wait here for the exchange, rather than being started again every round.
+  const auto step = [&]() noexcept {
+    next.store(0, std::memory_order_relaxed);
+    for (const auto &failure : errors) {
+      if (failure && !error) error = failure;
+    }
+    if (!error) {
+      try {
+        accepted += exchange();
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    round++;
+  };
+  std::barrier sync(static_cast<std::ptrdiff_t>(threads), step);
+  const auto work = [&] {
+    while (round < rounds_ && !error) {
+      for (std::size_t i = next++; i < replicas.size(); i = next++) {
+        try {
+          replicas[i]->sweep(attempts);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+      sync.arrive_and_wait();
+    }
+  };
+  std::vector<std::thread> workers{};
+  workers.reserve(threads - 1);
+  for (std::size_t i = 1; i < threads; i++) workers.emplace_back(work);
+  work();
+  for (auto &worker : workers) worker.join();
+  if (error) std::rethrow_exception(error);
+  return accepted;
+}
+
+std::size_t ParallelTempering::exchange() {
+  std::size_t accepted = 0;
+  for (std::size_t rung = rounds % 2; rung + 1 < ladder.size(); rung += 2) {
+    const std::size_t a = replicaAt[rung];
+    const std::size_t b = replicaAt[rung + 1];
+    const double before = replicas[a]->action(ladder[rung]) + replicas[b]->action(ladder[rung + 1]);
+    const double after = replicas[a]->action(ladder[rung + 1]) + replicas[b]->action(ladder[rung]);
+    const double ratio = std::exp(before - after);
+    swaps[rung].attempted++;
+    if (ratio < 1. && rng.uniform() >= ratio) continue;
+    swaps[rung].accepted++;
+    accepted++;
+    std::swap(replicaAt[rung], replicaAt[rung + 1]);
+    rungOf[a] = rung + 1;
+    rungOf[b] = rung;
+    replicas[a]->setCouplings(ladder[rung + 1]);
+    replicas[b]->setCouplings(ladder[rung]);
+  }
+  rounds++;
+  trackRoundTrips();
+  return accepted;
+}
+
+void ParallelTempering::seed(const std::uint64_t value) {
+  rng.seed(value, 0);
+  for (std::size_t i = 0; i < replicas.size(); i++) replicas[i]->seed(value, i + 1);
+}
+
+ParallelTempering::RoundTripStats ParallelTempering::getRoundTripStats() const noexcept {
+  return {roundTrips, roundTrips > 0 ? static_cast<double>(roundTripRounds) / static_cast<double>(roundTrips) : 0.};
+}
+
+void ParallelTempering::trackRoundTrips() {
+  if (ladder.size() < 2) return;
+  const std::size_t bottom = replicaAt.front();
+  if (headings[bottom] != Heading::Up) {
+    if (headings[bottom] == Heading::Down) {
+      roundTrips++;
+      roundTripRounds += rounds - departures[bottom];
+    }
+    headings[bottom] = Heading::Up;
+    departures[bottom] = rounds;
+  }
+  const std::size_t top = replicaAt.back();
+  if (headings[top] == Heading::Up) headings[top] = Heading::Down;
+}
+}
@@ -0,0 +1,337 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "spacetime/Spacetime.h"
+
+namespace caset {
+namespace {
+/// Maps vertex IDs to the rows `Spacetime::getVertexIdArray` gives them; IDs are dense, so this is a flat array.
+class VertexRows {
+  public:
+    explicit VertexRows(const VertexList &vertices) : firstId(vertices.getFirstId()) {
+      rows.assign(vertices.idBound() - firstId, -1);
+      std::int64_t row = 0;
+      vertices.forEach([&](const VertexPtr &vertex) { rows[vertex->getId() - firstId] = row++; });
+    }
+
+    std::int64_t operator()(const IdType id) const {
+      const std::int64_t row = id - firstId < rows.size() ? rows[id - firstId] : -1;
+      if (row < 0) throw std::logic_error("vertex " + std::to_string(id) + " is referenced but not listed");
+      return row;
+    }
+
+  private:
+    IdType firstId;
+    std::vector<std::int64_t> rows{};
+};
+
+/// @return The position of the pair (a, b), a < b, in (0, 1), (0, 2), ..., (0, k - 1), (1, 2), ...
+std::size_t pairIndex(const std::size_t a, const std::size_t b, const std::size_t k) noexcept {
+  return a * k - a * (a + 1) / 2 + (b - a - 1);
+}
+
+std::invalid_argument invalidArrays(const std::string &why) {
+  return std::invalid_argument("fromArrays: " + why);
+}
+}
+
+std::vector<std::int64_t> Spacetime::getVertexIdArray() const {
+  std::vector<std::int64_t> ids{};
+  ids.reserve(vertexList->size());
+  vertexList->forEach([&](const VertexPtr &vertex) { ids.push_back(static_cast<std::int64_t>(vertex->getId())); });
+  return ids;
+}
+
+std::vector<double> Spacetime::getTimeArray() const {
+  std::vector<double> times{};
+  times.reserve(vertexList->size());
+  vertexList->forEach([&](const VertexPtr &vertex) { times.push_back(vertex->getTime()); });
+  return times;
+}
+
+std::size_t Spacetime::getCoordinateWidth() const noexcept {
+  std::size_t width = 0;
+  vertexList->forEach([&](const VertexPtr &vertex) {
+    width = std::max(width, vertex->getCoordinatesOrEmpty().size());
+  });
+  return width;
+}
+
+std::vector<double> Spacetime::getCoordinateArray() const {
+  const std::size_t width = getCoordinateWidth();
+  std::vector<double> coordinates(vertexList->size() * width, std::numeric_limits<double>::quiet_NaN());
+  auto row = coordinates.begin();
+  vertexList->forEach([&](const VertexPtr &vertex) {
+    std::ranges::copy(vertex->getCoordinatesOrEmpty(), row);
+    row += static_cast<std::ptrdiff_t>(width);
+  });
+  return coordinates;
+}
+
+std::vector<std::int64_t> Spacetime::getEdgeArray() const {
+  const VertexRows rowOf(*vertexList);
+  std::vector<std::int64_t> endpoints{};
+  endpoints.reserve(2 * edgeList->size());
+  edgeList->forEach([&](const EdgePtr &edge) {
+    endpoints.push_back(rowOf(edge->getSourceId()));
+    endpoints.push_back(rowOf(edge->getTargetId()));
+  });
+  return endpoints;
+}
+
+std::vector<double> Spacetime::getSquaredLengthArray() const {
+  std::vector<double> lengths{};
+  lengths.reserve(edgeList->size());
+  edgeList->forEach([&](const EdgePtr &edge) { lengths.push_back(edge->getSquaredLength()); });
+  return lengths;
+}
+
+std::vector<std::int64_t> Spacetime::getSimplexArray() const {
+  const VertexRows rowOf(*vertexList);
+  std::vector<std::int64_t> simplices{};
+  simplices.reserve(getFaceCount(getDimension()) * (getDimension() + 1));
+  forEachTopSimplex([&](const SimplexPtr &simplex) {
+    for (const auto &vertex : simplex->getVertices()) simplices.push_back(rowOf(vertex->getId()));
+  });
+  return simplices;
+}
+
+std::shared_ptr<Spacetime> Spacetime::fromArrays(const std::span<const double> times,
+                                                 const std::span<const std::int64_t> simplices,
+                                                 const std::size_t width,
+                                                 const std::span<const double> squaredLengths) {
+  if (width < 2 || width > kMaxSimplexVertices) {
+    throw invalidArrays("simplices need between 2 and " + std::to_string(kMaxSimplexVertices) + " vertices");
+  }
+  if (simplices.size() % width != 0) throw invalidArrays("simplices must have " + std::to_string(width) + " columns");
+  const std::size_t n = simplices.size() / width;
+  const std::size_t pairs = width * (width - 1) / 2;
+  if (!squaredLengths.empty() && squaredLengths.size() != n * pairs) {
+    throw invalidArrays("squaredLengths must have " + std::to_string(pairs) + " entries per simplex");
+  }
+  if (times.size() > std::numeric_limits<std::uint32_t>::max()) throw invalidArrays("too many vertices");
+  for (const double time : times) {
+    if (!(time >= 0) || time != std::floor(time) || time > 0x1p53) {
+      throw invalidArrays("times must be whole, non-negative slice labels");
+    }
+  }
+
+  // Each row sorted by (time, index), the initial slice first, as the builders order a simplex's vertices. `columns`
+  // remembers where each vertex was in the input, to find its edges' lengths.
+  std::vector<std::uint32_t> rows(n * width);
+  std::vector<std::uint8_t> columns(n * width);
+  const auto before = [&](const std::uint32_t a, const std::uint32_t b) {
+    return times[a] != times[b] ? times[a] < times[b] : a < b;
+  };
+  for (std::size_t r = 0; r < n; r++) {
+    std::uint32_t *row = rows.data() + r * width;
+    std::uint8_t *column = columns.data() + r * width;
+    for (std::size_t c = 0; c < width; c++) {
+      const std::int64_t index = simplices[r * width + c];
+      if (index < 0 || static_cast<std::uint64_t>(index) >= times.size()) {
+        throw invalidArrays("simplex " + std::to_string(r) + " refers to vertex " + std::to_string(index) + " of " +
+                            std::to_string(times.size()));
+      }
+      column[c] = static_cast<std::uint8_t>(c);
+    }
+    std::sort(column, column + width, [&](const std::uint8_t a, const std::uint8_t b) {
+      return before(static_cast<std::uint32_t>(simplices[r * width + a]),
+                    static_cast<std::uint32_t>(simplices[r * width + b]));
+    });
+    for (std::size_t c = 0; c < width; c++) row[c] = static_cast<std::uint32_t>(simplices[r * width + column[c]]);
+    for (std::size_t c = 1; c < width; c++) {
+      if (row[c] == row[c - 1]) throw invalidArrays("simplex " + std::to_string(r) + " repeats a vertex");
+    }
+    if (times[row[width - 1]] - times[row[0]] != 1.) {
+      throw invalidArrays("simplex " + std::to_string(r) + " doesn't span two neighbouring slices");
+    }
+  }
+  const auto rowOf = [&](const std::size_t r) { return rows.data() + r * width; };
+
+  // Every edge once: each row's vertex pairs, sorted and merged.
+  struct Pair {
+    std::uint64_t key;
+    double squaredLength;
+  };
+  const auto keyOf = [](const std::uint32_t source, const std::uint32_t target) {
+    return static_cast<std::uint64_t>(source) << 32 | target;
+  };
+  std::vector<Pair> edgePairs{};
+  edgePairs.reserve(n * pairs);
+  for (std::size_t r = 0; r < n; r++) {
+    const std::uint32_t *row = rowOf(r);
+    const std::uint8_t *column = columns.data() + r * width;
+    for (std::size_t q = 1; q < width; q++) {
+      for (std::size_t p = 0; p < q; p++) {
+        const double squaredLength = squaredLengths.empty()
+                                       ? std::numeric_limits<double>::quiet_NaN()
+                                       : squaredLengths[r * pairs + pairIndex(std::min(column[p], column[q]),
+                                                                              std::max(column[p], column[q]), width)];
+        edgePairs.push_back({keyOf(row[p], row[q]), squaredLength});
+      }
+    }
+  }
+  std::ranges::sort(edgePairs, {}, &Pair::key);
+  std::vector<std::uint64_t> edgeKeys{};
+  std::vector<double> edgeLengths{};
+  for (const Pair &pair : edgePairs) {
+    if (!edgeKeys.empty() && edgeKeys.back() == pair.key) {
+      if (pair.squaredLength != edgeLengths.back() && !std::isnan(pair.squaredLength)) {
+        throw invalidArrays("simplices disagree on the squared length of edge (" + std::to_string(pair.key >> 32) +
+                            ", " + std::to_string(pair.key & 0xffffffffu) + ")");
+      }
+      continue;
+    }
+    edgeKeys.push_back(pair.key);
+    edgeLengths.push_back(pair.squaredLength);
+  }
+  edgePairs = {};
+
+  auto spacetime = std::make_shared<Spacetime>();
+  Spacetime &st = *spacetime;
+  st.reserve(times.size(), edgeKeys.size(), n * (width + 1));
+  st.vertexList->reserve(times.size());
+  st.edgeList->reserve(edgeKeys.size());
+  Vertices vertices(times.size());
+  for (std::size_t i = 0; i < times.size(); i++) vertices[i] = st.vertexList->add(i, {times[i]});
+  st.vertexIdCounter = times.size();
+  Edges edges(edgeKeys.size());
+  for (std::size_t e = 0; e < edgeKeys.size(); e++) {
+    const VertexPtr &source = vertices[edgeKeys[e] >> 32];
+    const VertexPtr &target = vertices[edgeKeys[e] & 0xffffffffu];
+    const double squaredLength = std::isnan(edgeLengths[e]) ? st.squaredLengthBetween(source, target) : edgeLengths[e];
+    edges[e] = st.edgeList->add(source->getId(), target->getId(), squaredLength);
+    source->addOutEdge(edges[e]);
+    target->addInEdge(edges[e]);
+  }
+
+  // Simplices with their edges in the order `createSimplex` cones them, sharing one orientation object per kind.
+  std::array<SimplexOrientationPtr, (kMaxSimplexVertices + 1) * (kMaxSimplexVertices + 1)> orientations{};
+  Simplices created(n);
+  Vertices simplexVertices{};
+  Edges simplexEdges{};
+  for (std::size_t r = 0; r < n; r++) {
+    const std::uint32_t *row = rowOf(r);
+    simplexVertices.clear();
+    for (std::size_t c = 0; c < width; c++) simplexVertices.push_back(vertices[row[c]]);
+    simplexEdges.clear();
+    for (std::size_t q = 1; q < width; q++) {
+      for (std::size_t p = 0; p < q; p++) {
+        const auto found = std::ranges::lower_bound(edgeKeys, keyOf(row[p], row[q]));
+        simplexEdges.push_back(edges[found - edgeKeys.begin()]);
+      }
+    }
+    const auto ti = static_cast<std::uint8_t>(
+      std::ranges::count_if(row, row + width, [&](const std::uint32_t v) { return times[v] == times[row[0]]; }));
+    const auto tf = static_cast<std::uint8_t>(width - ti);
+    SimplexOrientationPtr &orientation = orientations[ti * (kMaxSimplexVertices + 1) + tf];
+    if (!orientation) orientation = std::make_shared<SimplexOrientation>(ti, tf);
+    created[r] = Simplex::create(simplexVertices, simplexEdges, orientation, st.simplexPool.get());
+    st.countOrientation(created[r], 1);
+  }
+
+  // Facet `skip` of a row is the row without its `skip`-th vertex, still sorted, so equal facets sort together.
+  struct Facet {
+    std::uint32_t simplex;
+    std::uint8_t skip;
+  };
+  const auto vertexOf = [&](const Facet &facet, const std::size_t i) {
+    return rowOf(facet.simplex)[i + (i >= facet.skip)];
+  };
+  const auto compare = [&](const Facet &a, const Facet &b) {
+    for (std::size_t i = 0; i + 1 < width; i++) {
+      if (const auto x = vertexOf(a, i), y = vertexOf(b, i); x != y) return x < y ? -1 : 1;
+    }
+    return 0;
+  };
+  std::vector<Facet> facets{};
+  facets.reserve(n * width);
+  for (std::size_t r = 0; r < n; r++) {
+    for (std::size_t skip = 0; skip < width; skip++) {
+      facets.push_back({static_cast<std::uint32_t>(r), static_cast<std::uint8_t>(skip)});
+    }
+  }
+  std::ranges::sort(facets, [&](const Facet &a, const Facet &b) { return compare(a, b) < 0; });
+  std::size_t distinctFacets = 0;
+  for (std::size_t i = 0; i < facets.size(); distinctFacets++) {
+    std::size_t j = i + 1;
+    while (j < facets.size() && compare(facets[i], facets[j]) == 0) j++;
+    if (j - i > 2) {
+      throw invalidArrays("a facet of simplex " + std::to_string(facets[i].simplex) + " is shared by " +
+                          std::to_string(j - i) + " simplices");
+    }
+    if (j - i == 2) {
+      const Facet &a = facets[i], &b = facets[i + 1];
+      if (rowOf(a.simplex)[a.skip] == rowOf(b.simplex)[b.skip]) {
+        throw invalidArrays("simplices " + std::to_string(a.simplex) + " and " + std::to_string(b.simplex) +
+                            " are the same");
+      }
+      const SimplexPtr &simplex = created[a.simplex], &neighbour = created[b.simplex];
+      const SimplexPtr &mine = simplex->getFacets()[a.skip];
+      mine->addCoface(neighbour);
+      neighbour->getFacets()[b.skip]->addCoface(simplex);
+      simplex->markFacetGlued(a.skip);
+      neighbour->markFacetGlued(b.skip);
+      st.recordInternal(mine);
+    }
+    i = j;
+  }
+  for (const auto &simplex : created) {
+    if (simplex->getFreeFacets() == 0) continue;
+    st.addToBoundary(simplex);
+    st.registerFreeFacets(simplex);
+  }
+
+  // N_k for the faces of 3 or more vertices: the rows, the facets, and anything smaller counted by sorting.
+  if (n > 0) {
+    st.faceCounts.assign(width, 0);
+    st.faceCounts[width - 1] = n;
+    if (width - 1 >= 3) st.faceCounts[width - 2] = distinctFacets;
+    std::vector<std::array<std::uint32_t, kMaxSimplexVertices> > faces{};
+    for (std::size_t size = 3; size + 1 < width; size++) {
+      faces.clear();
+      for (std::size_t r = 0; r < n; r++) {
+        for (std::uint32_t mask = 0; mask < 1u << width; mask++) {
+          if (static_cast<std::size_t>(std::popcount(mask)) != size) continue;
+          std::array<std::uint32_t, kMaxSimplexVertices> face{};
+          std::size_t k = 0;
+          for (std::size_t c = 0; c < width; c++) {
+            if (mask >> c & 1u) face[k++] = rowOf(r)[c];
+          }
+          faces.push_back(face);
+        }
+      }
+      std::ranges::sort(faces);
+      st.faceCounts[size - 1] = static_cast<std::size_t>(std::unique(faces.begin(), faces.end()) - faces.begin());
+    }
+  }
+  return spacetime;
+}
+}
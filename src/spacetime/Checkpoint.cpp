@@ -0,0 +1,607 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "spacetime/Checkpoint.h"
+#include "spacetime/Spacetime.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CASET_HAVE_MMAP 1
+#endif
+
+namespace caset {
+namespace checkpoint {
+std::uint64_t checksum(const std::span<const std::byte> bytes) noexcept {
+  std::uint64_t hash = kSeed ^ bytes.size();
+  const auto mix = [&](const std::uint64_t word) {
+    hash = (hash ^ word) * 0x100000001B3ull;
+    hash ^= hash >> 29;
+  };
+  std::size_t i = 0;
+  for (; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, bytes.data() + i, sizeof(word));
+    mix(word);
+  }
+  if (i < bytes.size()) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, bytes.data() + i, bytes.size() - i);
+    mix(word);
+  }
+  return hash;
+}
+}
+
+Checkpoint::Checkpoint(const std::string &path) {
+#if CASET_HAVE_MMAP
+  const int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) throw std::runtime_error("cannot open checkpoint " + path + ": " + std::strerror(errno));
+  struct stat status{};
+  if (::fstat(descriptor, &status) == 0 && status.st_size > 0) {
+    void *address = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (address != MAP_FAILED) {
+      bytes = static_cast<const std::byte *>(address);
+      size = static_cast<std::size_t>(status.st_size);
+      mapped = true;
+    }
+  }
+  ::close(descriptor);
+#endif
+  if (!mapped) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) throw std::runtime_error("cannot open checkpoint " + path);
+    buffer.resize(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!in) throw std::runtime_error("cannot read checkpoint " + path);
+    bytes = buffer.data();
+    size = buffer.size();
+  }
+  try {
+    validate(path);
+  } catch (...) {
+#if CASET_HAVE_MMAP
+    if (mapped) ::munmap(const_cast<std::byte *>(bytes), size);
+#endif
+    throw;
+  }
+}
+
+Checkpoint::~Checkpoint() {
+#if CASET_HAVE_MMAP
+  if (mapped) ::munmap(const_cast<std::byte *>(bytes), size);
+#endif
+}
+
+const checkpoint::StateRecord &Checkpoint::getState() const {
+  return get<checkpoint::StateRecord>(checkpoint::Section::State).front();
+}
+
+const checkpoint::SectionEntry *Checkpoint::find(const checkpoint::Section tag) const noexcept {
+  const auto &header = *reinterpret_cast<const checkpoint::Header *>(bytes);
+  const auto *table = reinterpret_cast<const checkpoint::SectionEntry *>(bytes + sizeof(checkpoint::Header));
+  for (std::uint32_t i = 0; i < header.sections; i++) {
+    if (table[i].tag == static_cast<std::uint32_t>(tag)) return &table[i];
+  }
+  return nullptr;
+}
+
+void Checkpoint::validate(const std::string &path) const {
+  using namespace checkpoint;
+  const auto invalid = [&](const std::string &why) {
+    return std::runtime_error("invalid checkpoint " + path + ": " + why);
+  };
+  if (size < sizeof(Header)) throw invalid("too short for a header");
+  const auto &header = *reinterpret_cast<const Header *>(bytes);
+  if (header.magic != kMagic) throw invalid("not a caset checkpoint");
+  if (header.byteOrder != kByteOrderMark) throw invalid("written on a machine of the other byte order");
+  if (header.version != kVersion) {
+    throw invalid("format version " + std::to_string(header.version) + ", but this build reads version " +
+                  std::to_string(kVersion));
+  }
+  if (header.fileSize != size) {
+    throw invalid("expected " + std::to_string(header.fileSize) + " bytes but found " + std::to_string(size));
+  }
+  if (header.sections > (size - sizeof(Header)) / sizeof(SectionEntry)) throw invalid("section table is truncated");
+  const std::size_t tableEnd = sizeof(Header) + header.sections * sizeof(SectionEntry);
+  if (checksum({bytes + sizeof(Header), tableEnd - sizeof(Header)}) != header.checksum) {
+    throw invalid("section table checksum mismatch");
+  }
+
+  const auto *table = reinterpret_cast<const SectionEntry *>(bytes + sizeof(Header));
+  std::array<bool, kNumSections + 1> seen{};
+  for (std::uint32_t i = 0; i < header.sections; i++) {
+    const SectionEntry &entry = table[i];
+    const std::string name = "section " + std::to_string(entry.tag);
+    if (entry.tag < seen.size()) {
+      if (seen[entry.tag]) throw invalid(name + " appears twice");
+      seen[entry.tag] = true;
+    }
+    if (entry.recordSize == 0 || entry.offset % alignof(std::uint64_t) != 0 || entry.offset < tableEnd ||
+        entry.offset > size || entry.count > (size - entry.offset) / entry.recordSize) {
+      throw invalid(name + " lies outside the file");
+    }
+    if (checksum({bytes + entry.offset, entry.count * entry.recordSize}) != entry.checksum) {
+      throw invalid(name + " checksum mismatch");
+    }
+  }
+  const SectionEntry *state = find(Section::State);
+  if (state == nullptr || state->count != 1 || state->recordSize != sizeof(StateRecord)) {
+    throw invalid("missing its state record");
+  }
+}
+
+namespace {
+constexpr std::uint32_t kUnset = std::numeric_limits<std::uint32_t>::max();
+
+///
+/// The position of each record in its checkpoint section, found by the record's pool handle so that the lookup is an
+/// index. Records that weren't allocated from the pool fall back to a map.
+template<typename T>
+class RecordIndex {
+  public:
+    explicit RecordIndex(const Pool<T> &pool_) : pool(&pool_), positions(pool_.capacity(), kUnset) {
+    }
+
+    std::uint32_t &operator[](const T &record) {
+      if (record.getPool() == pool && record.getHandle().index() < positions.size()) {
+        return positions[record.getHandle().index()];
+      }
+      return unpooled.try_emplace(&record, kUnset).first->second;
+    }
+
+  private:
+    const Pool<T> *pool;
+    std::vector<std::uint32_t> positions;
+    std::unordered_map<const T *, std::uint32_t> unpooled{};
+};
+
+///
+/// Assembles sections and writes them out with the header and table. Sections are borrowed, so they have to outlive
+/// `write`.
+class Writer {
+  public:
+    template<typename T>
+    void add(const checkpoint::Section tag, const std::vector<T> &records) {
+      static_assert(std::is_trivially_copyable_v<T>);
+      sections.push_back({tag, sizeof(T), records.size(), reinterpret_cast<const std::byte *>(records.data())});
+    }
+
+    void write(const std::string &path) const {
+      using namespace checkpoint;
+      std::vector<SectionEntry> table{};
+      table.reserve(sections.size());
+      std::uint64_t offset = sizeof(Header) + sections.size() * sizeof(SectionEntry);
+      for (const auto &section : sections) {
+        offset = align(offset);
+        const std::size_t length = section.count * section.recordSize;
+        table.push_back({static_cast<std::uint32_t>(section.tag), static_cast<std::uint32_t>(section.recordSize),
+                         offset, section.count, checksum({section.data, length})});
+        offset += length;
+      }
+      Header header{};
+      header.magic = kMagic;
+      header.version = kVersion;
+      header.byteOrder = kByteOrderMark;
+      header.fileSize = offset;
+      header.sections = static_cast<std::uint32_t>(sections.size());
+      const std::size_t tableSize = table.size() * sizeof(SectionEntry);
+      header.checksum = checksum({reinterpret_cast<const std::byte *>(table.data()), tableSize});
+
+      const std::string partial = path + ".partial";
+      {
+        std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("cannot write checkpoint " + partial);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(table.data()), static_cast<std::streamsize>(tableSize));
+        std::uint64_t written = sizeof(Header) + tableSize;
+        constexpr std::array<char, alignof(std::uint64_t)> kPadding{};
+        for (std::size_t i = 0; i < sections.size(); i++) {
+          out.write(kPadding.data(), static_cast<std::streamsize>(table[i].offset - written));
+          const std::size_t length = sections[i].count * sections[i].recordSize;
+          out.write(reinterpret_cast<const char *>(sections[i].data), static_cast<std::streamsize>(length));
+          written = table[i].offset + length;
+        }
+        if (!out.flush()) throw std::runtime_error("cannot write checkpoint " + partial);
+      }
+      std::error_code error;
+      std::filesystem::rename(partial, path, error);
+      if (error) throw std::runtime_error("cannot move checkpoint into place at " + path + ": " + error.message());
+    }
+
+  private:
+    struct Pending {
+      checkpoint::Section tag;
+      std::size_t recordSize;
+      std::size_t count;
+      const std::byte *data;
+    };
+
+    std::vector<Pending> sections{};
+
+    static std::uint64_t align(const std::uint64_t offset) noexcept {
+      constexpr std::uint64_t alignment = alignof(std::uint64_t);
+      return (offset + alignment - 1) / alignment * alignment;
+    }
+};
+
+/// @return The next `count` items of `all` from `next`, which is advanced past them.
+template<typename T>
+std::span<const T> take(std::span<const T> all, std::size_t &next, const std::size_t count, const char *what) {
+  if (count > all.size() - next) throw std::runtime_error(std::string("checkpoint ") + what + " overrun their section");
+  const std::span<const T> taken = all.subspan(next, count);
+  next += count;
+  return taken;
+}
+
+/// @return `items[index]`, checking that it exists.
+template<typename T>
+const T &at(const std::vector<T> &items, const std::uint32_t index, const char *what) {
+  if (index >= items.size()) throw std::runtime_error(std::string("checkpoint refers to a missing ") + what);
+  return items[index];
+}
+
+/// @return `count` as a 32-bit record count or index.
+std::uint32_t narrow(const std::size_t count, const char *what) {
+  if (count > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::runtime_error(std::string("too many ") + what + " for the checkpoint format");
+  }
+  return static_cast<std::uint32_t>(count);
+}
+}
+
+void Spacetime::save(const std::string &path) const {
+  using namespace checkpoint;
+  Vertices vertices{};
+  Edges edges{};
+  Simplices simplices{};
+  RecordIndex<Vertex> vertexIndex(*vertexPool);
+  RecordIndex<Edge> edgeIndex(*edgePool);
+  RecordIndex<Simplex> simplexIndex(*simplexPool);
+  const auto vertexOf = [&](const VertexPtr &vertex) {
+    std::uint32_t &position = vertexIndex[*vertex];
+    if (position == kUnset) {
+      position = narrow(vertices.size(), "vertices");
+      vertices.push_back(vertex);
+    }
+    return position;
+  };
+  const auto edgeOf = [&](const EdgePtr &edge) {
+    std::uint32_t &position = edgeIndex[*edge];
+    if (position == kUnset) {
+      position = narrow(edges.size(), "edges");
+      edges.push_back(edge);
+    }
+    return position;
+  };
+  const auto simplexOf = [&](const SimplexPtr &simplex) {
+    std::uint32_t &position = simplexIndex[*simplex];
+    if (position == kUnset) {
+      position = narrow(simplices.size(), "simplices");
+      simplices.push_back(simplex);
+    }
+    return position;
+  };
+
+  // Listed vertices and edges come first, in the order they're listed, so restoring them is a straight append.
+  const VertexList &list = *vertexList;
+  for (IdType id = list.getFirstId(); id < list.idBound(); id++) {
+    if (const auto vertex = list.get(id)) vertexOf(vertex);
+  }
+  const std::size_t listedVertices = vertices.size();
+  for (const auto &edge : edgeList->toVector()) edgeOf(edge);
+  const std::size_t listedEdges = edges.size();
+
+  std::vector<BucketRecord> buckets{};
+  std::vector<std::uint32_t> bucketMembers{};
+  const auto addBucket = [&](const BucketRecord &bucket, const auto &members) {
+    buckets.push_back(bucket);
+    buckets.back().members = narrow(members.size(), "bucket members");
+    for (const auto &simplex : members) bucketMembers.push_back(simplexOf(simplex));
+  };
+  for (const auto &[orientation, bucket] : externalSimplices) {
+    const auto [ti, tf] = orientation->numeric();
+    addBucket({BucketKind::External, ti, tf, 0, 0, 0}, bucket);
+  }
+  for (const auto &[key, bucket] : freeFacets) {
+    addBucket({BucketKind::FreeFacet, key.ti, key.tf, static_cast<std::uint8_t>(key.timelike), 0, key.time}, bucket);
+  }
+  for (const auto &[orientation, bucket] : internalSimplices) {
+    const auto [ti, tf] = orientation->numeric();
+    addBucket({BucketKind::Internal, ti, tf, 0, 0, 0}, bucket);
+  }
+
+  std::vector<SiteRecord> sites{};
+  std::vector<std::uint32_t> siteVertices{};
+  for (std::size_t move = 0; move < kNumMoveTypes; move++) {
+    for (const auto &site : moveSites[move]) {
+      sites.push_back({static_cast<std::uint8_t>(move), static_cast<std::uint8_t>(site.ids().size()), 0, 0});
+      for (const IdType id : site.ids()) {
+        const VertexPtr vertex = list.get(id);
+        if (vertex == nullptr) throw std::logic_error("move site refers to missing vertex " + std::to_string(id));
+        siteVertices.push_back(vertexOf(vertex));
+      }
+    }
+  }
+
+  // Each record's links can reach records nothing else does, so this walks all three lists until none grows.
+  std::vector<VertexRecord> vertexRecords{};
+  std::vector<double> coordinates{};
+  std::vector<std::uint32_t> outEdges{}, inEdges{}, vertexSimplices{};
+  std::vector<EdgeRecord> edgeRecords{};
+  std::vector<std::uint32_t> edgeSimplices{};
+  std::vector<SimplexRecord> simplexRecords{};
+  std::vector<std::uint32_t> simplexVertices{}, simplexEdges{}, facets{}, cofaces{};
+  vertexRecords.reserve(vertices.size());
+  edgeRecords.reserve(edges.size());
+  simplexRecords.reserve(simplexPool->size());
+  while (vertexRecords.size() < vertices.size() || edgeRecords.size() < edges.size() ||
+         simplexRecords.size() < simplices.size()) {
+    for (std::size_t i = vertexRecords.size(); i < vertices.size(); i++) {
+      const VertexPtr vertex = vertices[i];
+      const std::vector<double> &position = vertex->getCoordinatesOrEmpty();
+      coordinates.insert(coordinates.end(), position.begin(), position.end());
+      for (const auto &edge : vertex->getOutEdges()) outEdges.push_back(edgeOf(edge));
+      for (const auto &edge : vertex->getInEdges()) inEdges.push_back(edgeOf(edge));
+      for (const auto &simplex : vertex->getSimplices()) vertexSimplices.push_back(simplexOf(simplex));
+      vertexRecords.push_back({
+        vertex->getId(), vertex->getTime(), narrow(position.size(), "coordinates"),
+        narrow(vertex->getOutEdges().size(), "edges"),
+        narrow(vertex->getInEdges().size(), "edges"),
+        narrow(vertex->getSimplices().size(), "simplices"), i < listedVertices ? kListed : 0u, 0
+      });
+    }
+    for (std::size_t i = edgeRecords.size(); i < edges.size(); i++) {
+      const EdgePtr edge = edges[i];
+      for (const auto &simplex : edge->getSimplices()) edgeSimplices.push_back(simplexOf(simplex));
+      edgeRecords.push_back({
+        edge->getSourceId(), edge->getTargetId(), edge->getSquaredLength(),
+        narrow(edge->getSimplices().size(), "simplices"), i < listedEdges ? kListed : 0u
+      });
+    }
+    for (std::size_t i = simplexRecords.size(); i < simplices.size(); i++) {
+      const SimplexPtr simplex = simplices[i];
+      for (const auto &vertex : simplex->vertices) simplexVertices.push_back(vertexOf(vertex));
+      for (const auto &edge : simplex->edges) simplexEdges.push_back(edgeOf(edge));
+      for (const auto &facet : simplex->facets) facets.push_back(simplexOf(facet));
+      for (const auto &coface : simplex->cofaces) cofaces.push_back(simplexOf(coface));
+      const auto [ti, tf] = simplex->orientation->numeric();
+      simplexRecords.push_back({
+        static_cast<std::uint8_t>(simplex->vertices.size()), ti, tf, simplex->freeFacets,
+        narrow(simplex->edges.size(), "edges"), narrow(simplex->facets.size(), "facets"),
+        narrow(simplex->cofaces.size(), "cofaces")
+      });
+    }
+  }
+
+  StateRecord state{};
+  state.vertexIdCounter = vertexIdCounter;
+  state.currentTime = currentTime;
+  state.firstId = list.getFirstId();
+  state.idBound = list.idBound();
+  state.rngSeed = rng.getSeed();
+  state.rngStream = rng.getStream();
+  state.rngPosition = rng.getPosition();
+  state.siteSimplexSize = siteSimplexSize;
+  state.alpha = alpha;
+  const std::shared_ptr<Signature> signature = metric->getSignature();
+  state.signatureDimensions = static_cast<std::uint32_t>(signature->getDimensions());
+  state.signatureType = static_cast<std::uint8_t>(signature->getSignatureType());
+  state.coordinateFree = metric->isCoordinateFree();
+  state.spacetimeType = static_cast<std::uint8_t>(spacetimeType);
+  const std::vector<StateRecord> states{state};
+  const std::vector<std::uint64_t> counts(faceCounts.begin(), faceCounts.end());
+  std::vector<OrientationCountRecord> orientations{};
+  for (const auto &[orientation, count] : orientationCounts) orientations.push_back({orientation, count});
+  std::ranges::sort(orientations, {}, &OrientationCountRecord::orientation);
+
+  Writer writer{};
+  writer.add(Section::State, states);
+  writer.add(Section::Vertices, vertexRecords);
+  writer.add(Section::Coordinates, coordinates);
+  writer.add(Section::Edges, edgeRecords);
+  writer.add(Section::Simplices, simplexRecords);
+  writer.add(Section::SimplexVertices, simplexVertices);
+  writer.add(Section::SimplexEdges, simplexEdges);
+  writer.add(Section::SimplexFacets, facets);
+  writer.add(Section::SimplexCofaces, cofaces);
+  writer.add(Section::VertexOutEdges, outEdges);
+  writer.add(Section::VertexInEdges, inEdges);
+  writer.add(Section::VertexSimplices, vertexSimplices);
+  writer.add(Section::EdgeSimplices, edgeSimplices);
+  writer.add(Section::Buckets, buckets);
+  writer.add(Section::BucketMembers, bucketMembers);
+  writer.add(Section::Sites, sites);
+  writer.add(Section::SiteVertices, siteVertices);
+  writer.add(Section::FaceCounts, counts);
+  writer.add(Section::OrientationCounts, orientations);
+  writer.write(path);
+}
+
+std::shared_ptr<Spacetime> Spacetime::load(const std::string &path,
+                                           std::optional<std::shared_ptr<Topology> > topology) {
+  using namespace checkpoint;
+  const Checkpoint file(path);
+  const StateRecord &state = file.getState();
+  Signature signature(static_cast<int>(state.signatureDimensions), static_cast<SignatureType>(state.signatureType));
+  auto spacetime = std::make_shared<Spacetime>(std::make_shared<Metric>(state.coordinateFree != 0, signature),
+                                               static_cast<SpacetimeType>(state.spacetimeType), state.alpha,
+                                               std::move(topology));
+  Spacetime &copy = *spacetime;
+
+  const auto vertexRecords = file.get<VertexRecord>(Section::Vertices);
+  const auto edgeRecords = file.get<EdgeRecord>(Section::Edges);
+  const auto simplexRecords = file.get<SimplexRecord>(Section::Simplices);
+  copy.reserve(vertexRecords.size(), edgeRecords.size(), simplexRecords.size());
+
+  Vertices vertices{};
+  vertices.reserve(vertexRecords.size());
+  copy.vertexList = std::make_shared<VertexList>(copy.vertexPool, state.firstId);
+  copy.vertexList->reserve(state.idBound);
+  const auto coordinates = file.get<double>(Section::Coordinates);
+  std::size_t nextCoordinate = 0;
+  for (const auto &record : vertexRecords) {
+    const auto position = take(coordinates, nextCoordinate, record.coordinates, "coordinates");
+    vertices.push_back(makePooled<Vertex>(copy.vertexPool.get(), record.id,
+                                          std::vector<double>(position.begin(), position.end())));
+    if ((record.flags & kListed) != 0) copy.vertexList->add(vertices.back());
+  }
+  copy.vertexList->extendTo(state.idBound);
+
+  Edges edges{};
+  edges.reserve(edgeRecords.size());
+  copy.edgeList->reserve(edgeRecords.size());
+  for (const auto &record : edgeRecords) {
+    edges.push_back(makePooled<Edge>(copy.edgePool.get(), record.source, record.target, record.squaredLength));
+    if ((record.flags & kListed) != 0) copy.edgeList->add(edges.back());
+  }
+
+  // Orientations are shared by every simplex that has them, as `SimplexOrientation::orientationOf` would give.
+  std::unordered_map<std::uint16_t, SimplexOrientationPtr> orientations{};
+  const auto orientationOf = [&](const std::uint8_t ti, const std::uint8_t tf) -> const SimplexOrientationPtr & {
+    auto &orientation = orientations[static_cast<std::uint16_t>(ti << 8 | tf)];
+    if (!orientation) orientation = std::make_shared<SimplexOrientation>(ti, tf);
+    return orientation;
+  };
+
+  Simplices simplices{};
+  simplices.reserve(simplexRecords.size());
+  const auto simplexVertices = file.get<std::uint32_t>(Section::SimplexVertices);
+  const auto simplexEdges = file.get<std::uint32_t>(Section::SimplexEdges);
+  std::size_t nextVertex = 0, nextEdge = 0;
+  std::vector<IdType> ids{};
+  for (const auto &record : simplexRecords) {
+    if (record.vertices == 0 || record.vertices > kMaxSimplexVertices) {
+      throw std::runtime_error("checkpoint has a simplex of " + std::to_string(record.vertices) + " vertices");
+    }
+    Vertices simplexVertexList{};
+    simplexVertexList.reserve(record.vertices);
+    ids.clear();
+    for (const std::uint32_t i : take(simplexVertices, nextVertex, record.vertices, "simplex vertices")) {
+      simplexVertexList.push_back(at(vertices, i, "vertex"));
+      ids.push_back(simplexVertexList.back()->getId());
+    }
+    Edges simplexEdgeList{};
+    simplexEdgeList.reserve(record.edges);
+    for (const std::uint32_t i : take(simplexEdges, nextEdge, record.edges, "simplex edges")) {
+      simplexEdgeList.push_back(at(edges, i, "edge"));
+    }
+    const SimplexPtr simplex = makePooled<Simplex>(copy.simplexPool.get(), std::move(simplexVertexList),
+                                                   std::move(simplexEdgeList), orientationOf(record.ti, record.tf));
+    simplex->fingerprint = SimplexFingerprint(ids);
+    simplex->freeFacets = record.freeFacets;
+    simplex->vertexIdLookup.reserve(simplex->vertices.size());
+    for (const auto &vertex : simplex->vertices) simplex->vertexIdLookup.emplace(vertex->getId(), vertex);
+    simplices.push_back(simplex);
+  }
+
+  const auto facets = file.get<std::uint32_t>(Section::SimplexFacets);
+  const auto cofaces = file.get<std::uint32_t>(Section::SimplexCofaces);
+  std::size_t nextFacet = 0, nextCoface = 0;
+  for (std::size_t s = 0; s < simplices.size(); s++) {
+    const SimplexPtr &simplex = simplices[s];
+    simplex->facets.reserve(simplexRecords[s].facets);
+    for (const std::uint32_t i : take(facets, nextFacet, simplexRecords[s].facets, "facets")) {
+      simplex->facets.push_back(at(simplices, i, "facet"));
+    }
+    simplex->cofaces.reserve(simplexRecords[s].cofaces);
+    for (const std::uint32_t i : take(cofaces, nextCoface, simplexRecords[s].cofaces, "cofaces")) {
+      simplex->cofaces.insert(at(simplices, i, "coface"));
+    }
+  }
+
+  const auto outEdges = file.get<std::uint32_t>(Section::VertexOutEdges);
+  const auto inEdges = file.get<std::uint32_t>(Section::VertexInEdges);
+  const auto vertexSimplices = file.get<std::uint32_t>(Section::VertexSimplices);
+  std::size_t nextOut = 0, nextIn = 0, nextSimplex = 0;
+  for (std::size_t v = 0; v < vertices.size(); v++) {
+    const VertexPtr &vertex = vertices[v];
+    for (const std::uint32_t i : take(outEdges, nextOut, vertexRecords[v].outEdges, "out-edges")) {
+      vertex->addOutEdge(at(edges, i, "edge"));
+    }
+    for (const std::uint32_t i : take(inEdges, nextIn, vertexRecords[v].inEdges, "in-edges")) {
+      vertex->addInEdge(at(edges, i, "edge"));
+    }
+    for (const std::uint32_t i : take(vertexSimplices, nextSimplex, vertexRecords[v].simplices, "vertex simplices")) {
+      vertex->addSimplex(at(simplices, i, "simplex"));
+    }
+  }
+  const auto edgeSimplices = file.get<std::uint32_t>(Section::EdgeSimplices);
+  std::size_t nextEdgeSimplex = 0;
+  for (std::size_t e = 0; e < edges.size(); e++) {
+    for (const std::uint32_t i : take(edgeSimplices, nextEdgeSimplex, edgeRecords[e].simplices, "edge simplices")) {
+      edges[e]->addSimplex(at(simplices, i, "simplex"));
+    }
+  }
+
+  const auto bucketMembers = file.get<std::uint32_t>(Section::BucketMembers);
+  std::size_t nextMember = 0;
+  for (const auto &bucket : file.get<BucketRecord>(Section::Buckets)) {
+    const auto members = take(bucketMembers, nextMember, bucket.members, "bucket members");
+    const auto fill = [&](auto &index) {
+      index.reserve(members.size());
+      for (const std::uint32_t i : members) index.insert(at(simplices, i, "bucket member"));
+    };
+    switch (bucket.kind) {
+      case BucketKind::External: fill(copy.externalSimplices[orientationOf(bucket.ti, bucket.tf)]); break;
+      case BucketKind::FreeFacet:
+        fill(copy.freeFacets[{bucket.ti, bucket.tf, bucket.timelike != 0, bucket.time}]);
+        break;
+      case BucketKind::Internal: fill(copy.internalSimplices[orientationOf(bucket.ti, bucket.tf)]); break;
+      default: throw std::runtime_error("checkpoint has a bucket of unknown kind");
+    }
+  }
+
+  const auto siteVertices = file.get<std::uint32_t>(Section::SiteVertices);
+  std::size_t nextSiteVertex = 0;
+  for (const auto &site : file.get<SiteRecord>(Section::Sites)) {
+    if (site.move >= kNumMoveTypes) throw std::runtime_error("checkpoint has a site for an unknown move");
+    ids.clear();
+    for (const std::uint32_t i : take(siteVertices, nextSiteVertex, site.vertices, "site vertices")) {
+      ids.push_back(at(vertices, i, "vertex")->getId());
+    }
+    copy.moveSites[site.move].insert(SimplexFingerprint(ids));
+  }
+
+  const auto counts = file.get<std::uint64_t>(Section::FaceCounts);
+  copy.faceCounts.assign(counts.begin(), counts.end());
+  for (const auto &[orientation, count] : file.get<OrientationCountRecord>(Section::OrientationCounts)) {
+    copy.orientationCounts[static_cast<std::uint16_t>(orientation)] = count;
+  }
+  copy.vertexIdCounter = state.vertexIdCounter;
+  copy.currentTime = state.currentTime;
+  copy.siteSimplexSize = state.siteSimplexSize;
+  copy.rng.seed(state.rngSeed, state.rngStream);
+  copy.rng.discard(state.rngPosition);
+  return spacetime;
+}
+} // caset
@@ -0,0 +1,368 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+
+#include "Simplex.h"
+#include "Varint.h"
+#include "spacetime/Checkpoint.h"
+#include "spacetime/ConfigurationLog.h"
+#include "spacetime/Spacetime.h"
+
+namespace caset {
+namespace {
+std::uint64_t checksumOf(const std::uint8_t *bytes, const std::size_t size) {
+  return checkpoint::checksum({reinterpret_cast<const std::byte *>(bytes), size});
+}
+}
+
+ConfigurationLog::ConfigurationLog(const std::string &path_, const std::size_t queueDepth_,
+                                   const std::size_t chunkBytes_)
+  : out(path_, std::ios::binary | std::ios::trunc), path(path_), queueDepth(std::max<std::size_t>(queueDepth_, 1)),
+    chunkBytes(chunkBytes_) {
+  if (!out) throw std::runtime_error("cannot open configuration log " + path);
+  const configlog::Header header{configlog::kMagic, configlog::kVersion, configlog::kByteOrderMark};
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  if (!out) throw std::runtime_error("cannot write configuration log " + path);
+  offset = sizeof(header);
+  writer = std::thread([this] { write(); });
+}
+
+ConfigurationLog::~ConfigurationLog() {
+  try {
+    close();
+  } catch (...) {
+  }
+}
+
+void ConfigurationLog::append(Spacetime &spacetime, const std::uint64_t sweep, const std::uint32_t chain) {
+  Frame frame{};
+  {
+    std::lock_guard lock(mutex);
+    check();
+    if (closing) throw std::logic_error("configuration log " + path + " is closed");
+    if (!spare.empty()) {
+      frame = std::move(spare.back());
+      spare.pop_back();
+    }
+  }
+
+  // Only the copy happens on the caller's thread.
+  frame.sweep = sweep;
+  frame.chain = chain;
+  frame.width = static_cast<std::uint32_t>(spacetime.getDimension() + 1);
+  frame.rows.clear();
+  spacetime.forEachTopSimplex([&](const SimplexPtr &simplex) {
+    const auto [ti, tf] = simplex->getOrientation()->numeric();
+    frame.rows.push_back(static_cast<IdType>(ti) << 8 | tf);
+    for (const auto &vertex : simplex->getVertices()) frame.rows.push_back(vertex->getId());
+  });
+
+  {
+    std::unique_lock lock(mutex);
+    changed.wait(lock, [&] { return pending.size() < queueDepth || error; });
+    check();
+    pending.push_back(std::move(frame));
+    appended++;
+  }
+  changed.notify_all();
+}
+
+void ConfigurationLog::flush() {
+  std::unique_lock lock(mutex);
+  check();
+  if (closed) return;
+  // Each call waits for its own target; the writer keeps going until it has reached the furthest one asked for.
+  const std::size_t target = appended;
+  flushTarget = std::max(flushTarget, target);
+  changed.notify_all();
+  changed.wait(lock, [&] { return written >= target || error; });
+  check();
+}
+
+void ConfigurationLog::close() {
+  {
+    std::lock_guard lock(mutex);
+    if (closed) return;
+    closing = true;
+  }
+  changed.notify_all();
+  writer.join();
+  out.close();
+  std::lock_guard lock(mutex);
+  closed = true;
+  check();
+}
+
+std::size_t ConfigurationLog::size() const {
+  std::lock_guard lock(mutex);
+  return appended;
+}
+
+void ConfigurationLog::check() const {
+  if (error) std::rethrow_exception(error);
+}
+
+void ConfigurationLog::write() {
+  std::unique_lock lock(mutex);
+  try {
+    for (;;) {
+      changed.wait(lock, [&] { return !pending.empty() || written < flushTarget || closing; });
+      if (!pending.empty()) {
+        Frame frame = std::move(pending.front());
+        pending.pop_front();
+        lock.unlock();
+        encode(frame);
+        if (chunk.size() >= chunkBytes) writeChunk();
+        lock.lock();
+        spare.push_back(std::move(frame));
+        changed.notify_all();
+        continue;
+      }
+      const bool last = closing;
+      lock.unlock();
+      writeChunk();
+      if (last) writeIndex();
+      out.flush();
+      if (!out) throw std::runtime_error("cannot write configuration log " + path);
+      lock.lock();
+      written = index.size();
+      changed.notify_all();
+      if (last) return;
+    }
+  } catch (...) {
+    if (!lock.owns_lock()) lock.lock();
+    error = std::current_exception();
+    changed.notify_all();
+  }
+}
+
+void ConfigurationLog::encode(Frame &frame) {
+  const std::size_t stride = frame.width + 1;
+  const std::size_t simplices = frame.rows.size() / stride;
+  IdType *const rows = frame.rows.data();
+  for (std::size_t i = 0; i < simplices; i++) std::sort(rows + i * stride + 1, rows + (i + 1) * stride);
+  order.resize(simplices);
+  std::iota(order.begin(), order.end(), 0u);
+  std::ranges::sort(order, [&](const std::uint32_t a, const std::uint32_t b) {
+    return std::lexicographical_compare(rows + a * stride, rows + (a + 1) * stride, rows + b * stride,
+                                        rows + (b + 1) * stride);
+  });
+
+  std::vector<std::uint8_t> &bytes = scratch;
+  bytes.clear();
+  encodeVarint(bytes, frame.chain);
+  encodeVarint(bytes, frame.sweep);
+  encodeVarint(bytes, frame.width);
+  std::vector<std::pair<IdType, std::size_t> > groups{};
+  for (const std::uint32_t i : order) {
+    if (groups.empty() || groups.back().first != rows[i * stride]) groups.emplace_back(rows[i * stride], 0);
+    groups.back().second++;
+  }
+  encodeVarint(bytes, groups.size());
+  for (const auto &[key, count] : groups) {
+    encodeVarint(bytes, key >> 8);
+    encodeVarint(bytes, key & 0xff);
+    encodeVarint(bytes, count);
+  }
+  IdType key = ~IdType{0}, previous = 0;
+  for (const std::uint32_t i : order) {
+    const IdType *row = rows + i * stride;
+    if (row[0] != key) {
+      key = row[0];
+      previous = 0;
+    }
+    encodeVarint(bytes, row[1] - previous);
+    previous = row[1];
+    for (std::size_t j = 2; j < stride; j++) {
+      if (row[j] <= row[j - 1]) throw std::logic_error("simplex repeats vertex " + std::to_string(row[j]));
+      encodeVarint(bytes, row[j] - row[j - 1] - 1);
+    }
+  }
+
+  encodeVarint(chunk, bytes.size());
+  index.push_back({offset + sizeof(configlog::ChunkHeader) + chunk.size(), frame.sweep,
+                   checksumOf(bytes.data(), bytes.size()), static_cast<std::uint32_t>(bytes.size()), frame.chain});
+  chunk.insert(chunk.end(), bytes.begin(), bytes.end());
+  chunkFrames++;
+  frame.rows.clear();
+}
+
+void ConfigurationLog::writeChunk() {
+  if (chunkFrames == 0) return;
+  const configlog::ChunkHeader header{configlog::kChunkTag, chunkFrames, chunk.size(),
+                                      checksumOf(chunk.data(), chunk.size())};
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+  if (!out) throw std::runtime_error("cannot write configuration log " + path);
+  offset += sizeof(header) + chunk.size();
+  chunk.clear();
+  chunkFrames = 0;
+}
+
+void ConfigurationLog::writeIndex() {
+  const std::size_t bytes = index.size() * sizeof(configlog::FrameEntry);
+  const configlog::Trailer trailer{index.size(), offset,
+                                   checksumOf(reinterpret_cast<const std::uint8_t *>(index.data()), bytes),
+                                   configlog::kEndMagic};
+  out.write(reinterpret_cast<const char *>(index.data()), static_cast<std::streamsize>(bytes));
+  out.write(reinterpret_cast<const char *>(&trailer), sizeof(trailer));
+  if (!out) throw std::runtime_error("cannot write configuration log " + path);
+  offset += bytes + sizeof(trailer);
+}
+
+ConfigurationReader::ConfigurationReader(const std::string &path_) : in(path_, std::ios::binary), path(path_) {
+  if (!in) throw std::runtime_error("cannot open configuration log " + path);
+  in.seekg(0, std::ios::end);
+  const auto size = static_cast<std::uint64_t>(in.tellg());
+  in.seekg(0);
+  configlog::Header header{};
+  if (size < sizeof(header) || !in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      header.magic != configlog::kMagic) {
+    throw std::runtime_error(path + " is not a caset configuration log");
+  }
+  if (header.byteOrder != configlog::kByteOrderMark) {
+    throw std::runtime_error(path + " was written on a machine of the other byte order");
+  }
+  if (header.version != configlog::kVersion) {
+    throw std::runtime_error(path + " is format version " + std::to_string(header.version) +
+                             ", but this build reads version " + std::to_string(configlog::kVersion));
+  }
+  complete = readIndex(size);
+  if (!complete) scan(size);
+}
+
+bool ConfigurationReader::readIndex(const std::uint64_t size) {
+  using configlog::FrameEntry;
+  configlog::Trailer trailer{};
+  if (size < sizeof(configlog::Header) + sizeof(trailer)) return false;
+  in.seekg(static_cast<std::streamoff>(size - sizeof(trailer)));
+  if (!in.read(reinterpret_cast<char *>(&trailer), sizeof(trailer)) || trailer.magic != configlog::kEndMagic) {
+    in.clear();
+    return false;
+  }
+  if (trailer.indexOffset < sizeof(configlog::Header) || trailer.indexOffset > size - sizeof(trailer)) return false;
+  const std::uint64_t bytes = size - sizeof(trailer) - trailer.indexOffset;
+  if (bytes % sizeof(FrameEntry) != 0 || bytes / sizeof(FrameEntry) != trailer.frames) return false;
+  std::vector<FrameEntry> entries(trailer.frames);
+  in.seekg(static_cast<std::streamoff>(trailer.indexOffset));
+  if (!in.read(reinterpret_cast<char *>(entries.data()), static_cast<std::streamsize>(bytes)) ||
+      checksumOf(reinterpret_cast<const std::uint8_t *>(entries.data()), bytes) != trailer.indexChecksum) {
+    in.clear();
+    return false;
+  }
+  for (const FrameEntry &entry : entries) {
+    if (entry.offset > trailer.indexOffset || entry.bytes > trailer.indexOffset - entry.offset) return false;
+  }
+  index = std::move(entries);
+  return true;
+}
+
+void ConfigurationReader::scan(const std::uint64_t size) {
+  std::uint64_t position = sizeof(configlog::Header);
+  configlog::ChunkHeader header{};
+  while (size - position >= sizeof(header)) {
+    in.seekg(static_cast<std::streamoff>(position));
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.tag != configlog::kChunkTag ||
+        header.bytes > size - position - sizeof(header)) {
+      break;
+    }
+    buffer.resize(header.bytes);
+    if (!in.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size())) ||
+        checksumOf(buffer.data(), buffer.size()) != header.checksum) {
+      break;
+    }
+    const std::uint8_t *const begin = buffer.data(), *const end = begin + buffer.size();
+    const std::uint8_t *p = begin;
+    for (std::uint32_t i = 0; i < header.frames; i++) {
+      const std::uint64_t bytes = decodeVarint(p, end);
+      if (bytes > static_cast<std::uint64_t>(end - p)) {
+        throw std::runtime_error(path + " has a frame overrunning its chunk");
+      }
+      const std::uint8_t *frame = p;
+      const auto chain = static_cast<std::uint32_t>(decodeVarint(frame, p + bytes));
+      const std::uint64_t sweep = decodeVarint(frame, p + bytes);
+      index.push_back({position + sizeof(header) + static_cast<std::uint64_t>(p - begin), sweep,
+                       checksumOf(p, bytes), static_cast<std::uint32_t>(bytes), chain});
+      p += bytes;
+    }
+    position += sizeof(header) + header.bytes;
+  }
+  in.clear();
+}
+
+ConfigurationReader::Frame ConfigurationReader::getFrame(const std::size_t i) {
+  const configlog::FrameEntry &entry = index.at(i);
+  buffer.resize(entry.bytes);
+  in.seekg(static_cast<std::streamoff>(entry.offset));
+  if (!in.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+    in.clear();
+    throw std::runtime_error("cannot read frame " + std::to_string(i) + " of " + path);
+  }
+  if (checksumOf(buffer.data(), buffer.size()) != entry.checksum) {
+    throw std::runtime_error("frame " + std::to_string(i) + " of " + path + " doesn't match its checksum");
+  }
+
+  const std::uint8_t *p = buffer.data(), *const end = p + buffer.size();
+  Frame frame{};
+  frame.chain = static_cast<std::uint32_t>(decodeVarint(p, end));
+  frame.sweep = decodeVarint(p, end);
+  const std::uint64_t width = decodeVarint(p, end);
+  const std::uint64_t groups = decodeVarint(p, end);
+  // Every simplex takes at least a byte per vertex, which bounds what a damaged count can make us allocate.
+  if (width == 0 || width > 0xff || groups > static_cast<std::uint64_t>(end - p)) {
+    throw std::runtime_error("frame " + std::to_string(i) + " of " + path + " has a malformed header");
+  }
+  frame.width = static_cast<std::uint32_t>(width);
+  std::vector<std::array<std::uint64_t, 3> > orientations(groups);
+  std::uint64_t simplices = 0;
+  for (auto &[ti, tf, count] : orientations) {
+    ti = decodeVarint(p, end);
+    tf = decodeVarint(p, end);
+    count = decodeVarint(p, end);
+    if (ti > 0xff || tf > 0xff || count > static_cast<std::uint64_t>(end - p) / width) {
+      throw std::runtime_error("frame " + std::to_string(i) + " of " + path + " has a malformed orientation group");
+    }
+    simplices += count;
+  }
+  frame.vertices.reserve(simplices * width);
+  frame.orientations.reserve(simplices * 2);
+  for (const auto &[ti, tf, count] : orientations) {
+    IdType previous = 0;
+    for (std::uint64_t s = 0; s < count; s++) {
+      IdType id = previous + decodeVarint(p, end);
+      previous = id;
+      frame.vertices.push_back(id);
+      for (std::uint64_t j = 1; j < width; j++) {
+        id += decodeVarint(p, end) + 1;
+        frame.vertices.push_back(id);
+      }
+      frame.orientations.push_back(static_cast<std::uint8_t>(ti));
+      frame.orientations.push_back(static_cast<std::uint8_t>(tf));
+    }
+  }
+  if (p != end) throw std::runtime_error("frame " + std::to_string(i) + " of " + path + " has trailing bytes");
+  return frame;
+}
+}
@@ -0,0 +1,408 @@
+// MIT License
+// Copyright (c) 2025 Andrew Kelleher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Fingerprint.h"
+#include "spacetime/Spacetime.h"
+
+namespace caset {
+namespace {
+/// One end of an edge as seen from the other, with its SMACOF target distance and weight.
+struct Neighbour {
+  std::uint32_t row;
+  double distance;
+  double weight;
+};
+
+inline constexpr std::size_t kRowsPerUnit = 1024;
+/// Offsets the Spacetime's stream to give the layout a stream no chain or replica uses.
+inline constexpr std::uint64_t kEmbeddingStream = 0x656d626564ull;
+
+/// A vertex row filed under the hash of its grid cell.
+struct Cell {
+  std::uint64_t key;
+  std::uint32_t row;
+};
+
+/// A worker's buffers for the repulsion grid, reused across iterations.
+struct Scratch {
+  explicit Scratch(const std::size_t spatial) : cell(spatial), around(spatial) {}
+
+  std::vector<Cell> grid{};
+  std::vector<std::uint64_t> keys{};
+  std::vector<std::int64_t> cell;
+  std::vector<std::int64_t> around;
+};
+}
+
+EmbeddingStats Spacetime::embed(const EmbeddingOptions &options) {
+  using Clock = std::chrono::steady_clock;
+  const auto started = Clock::now();
+  const auto secondsSince = [](const Clock::time_point start) noexcept {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  };
+  if (options.dimensions < 1) throw std::invalid_argument("embed needs at least one dimension");
+
+  EmbeddingStats stats{};
+  const auto dims = static_cast<std::size_t>(options.dimensions);
+  const std::vector<double> times = getTimeArray();
+  const std::size_t n = times.size();
+  if (n == 0) return stats;
+  if (n > std::numeric_limits<std::uint32_t>::max()) throw std::length_error("too many vertices to embed");
+
+  // Each vertex's edges as compressed rows, so an iteration streams through one array.
+  const std::vector<std::int64_t> endpoints = getEdgeArray();
+  const std::vector<double> squaredLengths = getSquaredLengthArray();
+  std::vector<std::size_t> offsets(n + 1, 0);
+  for (const std::int64_t row : endpoints) offsets[row + 1]++;
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<Neighbour> neighbours(endpoints.size());
+  std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+  for (std::size_t e = 0; e < squaredLengths.size(); e++) {
+    const auto source = static_cast<std::uint32_t>(endpoints[2 * e]);
+    const auto target = static_cast<std::uint32_t>(endpoints[2 * e + 1]);
+    const double distance = std::sqrt(std::max(std::abs(squaredLengths[e]), options.epsilon));
+    const double weight = 1. / (distance * distance);
+    neighbours[fill[source]++] = {target, distance, weight};
+    neighbours[fill[target]++] = {source, distance, weight};
+  }
+
+  // Each row's neighbours' IDs, summed as hashes so their order doesn't matter.
+  const std::vector<std::int64_t> ids = getVertexIdArray();
+  std::vector<std::uint64_t> signatures(n, 0);
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t e = offsets[i]; e < offsets[i + 1]; e++) {
+      signatures[i] += EdgeFingerprint::mix64(static_cast<IdType>(ids[neighbours[e].row]));
+    }
+  }
+
+  const bool repel = options.repulsion > 0. && dims > 1;
+  if (repel && !(options.repulsionCutoff > 0.)) throw std::invalid_argument("embed needs a positive repulsionCutoff");
+  const double cutoff = options.repulsionCutoff;
+  const std::size_t spatial = dims - 1;
+  std::size_t around = 1;
+  if (repel) {
+    for (std::size_t k = 0; k < spatial; k++) around *= 3;
+  }
+
+  // Incrementally, a row is placed if the last layout has its vertex, and changed if it's new or its neighbours aren't
+  // the ones it was fit among. The rows within `hops` edges of a changed one are active; the rest hold still.
+  const bool warm = options.incremental && layoutDimensions == dims;
+  std::vector<char> placed(n, 0);
+  std::vector<char> active(n, 1);
+  if (warm) {
+    std::vector<std::uint32_t> frontier{};
+    for (std::size_t i = 0; i < n; i++) {
+      const auto id = static_cast<std::size_t>(ids[i]);
+      placed[i] = (id + 1) * dims <= layout.size() && !std::isnan(layout[id * dims]);
+      active[i] = !placed[i] || id >= layoutSignatures.size() || layoutSignatures[id] != signatures[i];
+      if (active[i]) frontier.push_back(static_cast<std::uint32_t>(i));
+    }
+    std::vector<std::uint32_t> reached{};
+    for (std::size_t hop = 0; hop < options.hops && !frontier.empty(); hop++) {
+      reached.clear();
+      for (const std::uint32_t row : frontier) {
+        for (std::size_t e = offsets[row]; e < offsets[row + 1]; e++) {
+          const std::uint32_t other = neighbours[e].row;
+          if (active[other]) continue;
+          active[other] = 1;
+          reached.push_back(other);
+        }
+      }
+      frontier.swap(reached);
+    }
+  }
+
+  // Workers take units of active rows from `order` as they free up. With repulsion a unit is a whole slice, so one
+  // worker builds and reads that slice's grid; otherwise it's a fixed number of rows. Either way the units don't depend
+  // on the thread count.
+  std::vector<std::uint32_t> order{};
+  order.reserve(n);
+  for (std::size_t i = 0; i < n; i++) {
+    if (active[i]) order.push_back(static_cast<std::uint32_t>(i));
+  }
+  const std::size_t m = order.size();
+  stats.vertices = m;
+  stats.converged = m == 0;
+  std::vector<std::size_t> units{0};
+  if (repel) {
+    std::ranges::stable_sort(order, {}, [&](const std::uint32_t row) { return times[row]; });
+    for (std::size_t p = 1; p < m; p++) {
+      if (times[order[p]] != times[order[p - 1]]) units.push_back(p);
+    }
+  } else {
+    for (std::size_t p = kRowsPerUnit; p < m; p += kRowsPerUnit) units.push_back(p);
+  }
+  units.push_back(m);
+  const std::size_t unitCount = units.size() - 1;
+
+  std::size_t threads = options.threads;
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::max<std::size_t>(1, std::min(threads, m));
+
+  Rng noise = options.seed ? Rng(*options.seed) : rng.split(rng.getStream() ^ kEmbeddingStream);
+  std::vector<double> current(n * dims);
+  if (warm) {
+    std::vector<std::uint32_t> pending{};
+    for (std::size_t i = 0; i < n; i++) {
+      double *x = current.data() + i * dims;
+      x[0] = times[i];
+      if (placed[i]) {
+        std::copy_n(layout.begin() + static_cast<std::ptrdiff_t>(ids[i] * static_cast<std::int64_t>(dims)) + 1, spatial,
+                    x + 1);
+      } else {
+        pending.push_back(static_cast<std::uint32_t>(i));
+      }
+    }
+    // New rows are placed a layer at a time outwards from the placed ones, each at the barycenter of its placed
+    // neighbours plus a tenth of an edge of noise. Rows with no path to a placed one start at random.
+    std::vector<std::uint32_t> waiting{};
+    std::vector<std::uint32_t> layer{};
+    while (!pending.empty()) {
+      waiting.clear();
+      layer.clear();
+      for (const std::uint32_t row : pending) {
+        double *x = current.data() + static_cast<std::size_t>(row) * dims;
+        std::fill(x + 1, x + dims, 0.);
+        double count = 0.;
+        double reach = 0.;
+        for (std::size_t e = offsets[row]; e < offsets[row + 1]; e++) {
+          if (!placed[neighbours[e].row]) continue;
+          const double *y = current.data() + static_cast<std::size_t>(neighbours[e].row) * dims;
+          for (std::size_t k = 1; k < dims; k++) x[k] += y[k];
+          count += 1.;
+          reach += neighbours[e].distance;
+        }
+        if (count == 0.) {
+          waiting.push_back(row);
+          continue;
+        }
+        for (std::size_t k = 1; k < dims; k++) x[k] = x[k] / count + 0.1 * reach / count * noise.normal();
+        layer.push_back(row);
+      }
+      if (layer.empty()) {
+        for (const std::uint32_t row : waiting) {
+          for (std::size_t k = 1; k < dims; k++) current[static_cast<std::size_t>(row) * dims + k] = noise.normal();
+        }
+        break;
+      }
+      for (const std::uint32_t row : layer) placed[row] = 1;
+      pending.swap(waiting);
+    }
+  } else {
+    // With repulsion, the start is spread so that the largest slice has about one vertex per cell. Packed any tighter,
+    // every vertex would have most of its slice in the cells around it.
+    double spread = 1.;
+    if (repel) {
+      std::size_t largest = 0;
+      for (std::size_t unit = 0; unit < unitCount; unit++) largest = std::max(largest, units[unit + 1] - units[unit]);
+      spread = std::max(1., cutoff * std::pow(static_cast<double>(largest), 1. / static_cast<double>(spatial)));
+    }
+    for (std::size_t i = 0; i < n; i++) {
+      current[i * dims] = times[i];
+      for (std::size_t k = 1; k < dims; k++) current[i * dims + k] = spread * noise.normal();
+    }
+  }
+  std::vector<double> next = current;
+
+  const auto cellOf = [&](const double *x, std::vector<std::int64_t> &cell) {
+    for (std::size_t k = 0; k < spatial; k++) cell[k] = static_cast<std::int64_t>(std::floor(x[k + 1] / cutoff));
+  };
+  const auto keyOf = [&](const std::vector<std::int64_t> &cell) {
+    std::uint64_t key = 0;
+    for (const std::int64_t c : cell) key = (key ^ static_cast<std::uint64_t>(c)) * 0x9e3779b97f4a7c15ull;
+    return key;
+  };
+
+  // The rows holding still don't move, so each slice being refit files its still rows once, for the active ones to
+  // push against.
+  std::vector<std::vector<Cell> > anchors(repel && warm && m > 0 ? unitCount : 0);
+  if (!anchors.empty()) {
+    std::vector<double> unitTimes(unitCount);
+    for (std::size_t unit = 0; unit < unitCount; unit++) unitTimes[unit] = times[order[units[unit]]];
+    std::vector<std::int64_t> cell(spatial);
+    for (std::size_t i = 0; i < n; i++) {
+      if (active[i]) continue;
+      const auto slice = std::ranges::lower_bound(unitTimes, times[i]);
+      if (slice == unitTimes.end() || *slice != times[i]) continue;
+      cellOf(current.data() + i * dims, cell);
+      anchors[slice - unitTimes.begin()].push_back({keyOf(cell), static_cast<std::uint32_t>(i)});
+    }
+    for (auto &grid : anchors) std::ranges::sort(grid, {}, &Cell::key);
+  }
+
+  // Stress of `from` over the edges (and, with repulsion, the close same-slice pairs) of a unit's rows, so each pair
+  // is counted from both ends. When `to` isn't null, also writes the rows' Guttman transform there.
+  const auto iterate = [&](const std::size_t unit, const double *from, double *to, Scratch &scratch) {
+    const std::size_t begin = units[unit];
+    const std::size_t end = units[unit + 1];
+    if (repel) {
+      scratch.grid.clear();
+      for (std::size_t p = begin; p < end; p++) {
+        cellOf(from + static_cast<std::size_t>(order[p]) * dims, scratch.cell);
+        scratch.grid.push_back({keyOf(scratch.cell), order[p]});
+      }
+      std::ranges::sort(scratch.grid, {}, &Cell::key);
+    }
+
+    double stress = 0.;
+    double total = 0.;
+    // Adds the pair with `row` at `target` distance with `weight`, as seen from x. A pair with a row holding still is
+    // only seen from this end, so it counts twice to keep the halved sum the stress.
+    const auto pair = [&](const double *x, const std::uint32_t row, double *out, const double target,
+                          const double weight, const bool hinge) {
+      const double *y = from + static_cast<std::size_t>(row) * dims;
+      double squared = 0.;
+      for (std::size_t k = 0; k < dims; k++) squared += (x[k] - y[k]) * (x[k] - y[k]);
+      const double distance = std::sqrt(squared);
+      if (hinge && distance >= target) return;
+      stress += (active[row] ? 1. : 2.) * weight * (distance - target) * (distance - target);
+      if (out == nullptr) return;
+      // Where this neighbour would put x: `target` away from it, in x's current direction.
+      const double pull = distance > 0. ? target / distance : 0.;
+      for (std::size_t k = 1; k < dims; k++) out[k] += weight * (y[k] + pull * (x[k] - y[k]));
+      total += weight;
+    };
+
+    for (std::size_t p = begin; p < end; p++) {
+      const std::size_t i = order[p];
+      const double *x = from + i * dims;
+      double *out = to == nullptr ? nullptr : to + i * dims;
+      if (out != nullptr) std::fill(out + 1, out + dims, 0.);
+      total = 0.;
+      for (std::size_t e = offsets[i]; e < offsets[i + 1]; e++) {
+        pair(x, neighbours[e].row, out, neighbours[e].distance, neighbours[e].weight, false);
+      }
+      if (repel) {
+        // The keys of the 3^(d - 1) cells around x's, each looked up once even if two of them collide.
+        cellOf(x, scratch.cell);
+        scratch.keys.clear();
+        for (std::size_t offset = 0; offset < around; offset++) {
+          std::size_t digits = offset;
+          for (std::size_t k = 0; k < spatial; k++, digits /= 3) {
+            scratch.around[k] = scratch.cell[k] + static_cast<std::int64_t>(digits % 3) - 1;
+          }
+          scratch.keys.push_back(keyOf(scratch.around));
+        }
+        std::ranges::sort(scratch.keys);
+        scratch.keys.erase(std::ranges::unique(scratch.keys).begin(), scratch.keys.end());
+        const auto repelFrom = [&](const std::vector<Cell> &grid) {
+          for (const std::uint64_t key : scratch.keys) {
+            for (const Cell &cell : std::ranges::equal_range(grid, key, {}, &Cell::key)) {
+              if (cell.row == i) continue;
+              pair(x, cell.row, out, cutoff, options.repulsion, true);
+            }
+          }
+        };
+        repelFrom(scratch.grid);
+        if (!anchors.empty()) repelFrom(anchors[unit]);
+      }
+      if (out == nullptr) continue;
+      out[0] = x[0];
+      if (total > 0.) {
+        for (std::size_t k = 1; k < dims; k++) out[k] /= total;
+      } else {
+        std::copy(x + 1, x + dims, out + 1);
+      }
+    }
+    return stress;
+  };
+
+  std::vector<Scratch> scratch(threads, Scratch(spatial));
+  std::vector<double> unitStress(unitCount, 0.);
+  std::atomic<std::size_t> nextUnit{0};
+  double previous = 0.;
+  bool stop = options.maxIterations == 0 || dims == 1 || m == 0;
+
+  // Runs on one thread between iterations, once every worker has measured `current` and written `next`. The units'
+  // stresses are summed in order, so the result doesn't depend on which worker took which unit.
+  const auto step = [&]() noexcept {
+    nextUnit.store(0, std::memory_order_relaxed);
+    const double stress = std::accumulate(unitStress.begin(), unitStress.end(), 0.) / 2.;
+    if (stats.iterations > 0 && stress <= previous && previous - stress <= options.tolerance * previous) {
+      stats.converged = true;
+      stop = true;
+      return;
+    }
+    current.swap(next);
+    previous = stress;
+    stats.iterations++;
+    if (stats.iterations >= options.maxIterations) stop = true;
+    if (options.timeBudget > 0. && secondsSince(started) >= options.timeBudget) stop = true;
+  };
+  std::barrier sync(static_cast<std::ptrdiff_t>(threads), step);
+  const auto work = [&](const std::size_t worker) {
+    while (!stop) {
+      for (std::size_t unit = nextUnit++; unit < unitCount; unit = nextUnit++) {
+        unitStress[unit] = iterate(unit, current.data(), next.data(), scratch[worker]);
+      }
+      sync.arrive_and_wait();
+    }
+  };
+  if (!stop) {
+    std::vector<std::thread> workers{};
+    workers.reserve(threads - 1);
+    for (std::size_t worker = 1; worker < threads; worker++) workers.emplace_back(work, worker);
+    work(0);
+    for (auto &worker : workers) worker.join();
+  }
+
+  stats.stress = 0.;
+  for (std::size_t unit = 0; unit < unitCount; unit++) {
+    stats.stress += iterate(unit, current.data(), nullptr, scratch[0]) / 2.;
+  }
+  layoutDimensions = dims;
+  layout.assign(vertexList->idBound() * dims, std::numeric_limits<double>::quiet_NaN());
+  const double *position = current.data();
+  vertexList->forEach([&](const VertexPtr &vertex) {
+    std::copy(position, position + dims, layout.begin() + static_cast<std::ptrdiff_t>(vertex->getId() * dims));
+    position += dims;
+  });
+  layoutSignatures.assign(vertexList->idBound(), 0);
+  for (std::size_t i = 0; i < n; i++) layoutSignatures[static_cast<std::size_t>(ids[i])] = signatures[i];
+  stats.seconds = secondsSince(started);
+  return stats;
+}
+
+std::vector<double> Spacetime::getLayoutArray() const {
+  std::vector<double> positions(vertexList->size() * layoutDimensions, std::numeric_limits<double>::quiet_NaN());
+  auto row = positions.begin();
+  vertexList->forEach([&](const VertexPtr &vertex) {
+    const std::size_t offset = vertex->getId() * layoutDimensions;
+    if (offset < layout.size()) {
+      std::copy_n(layout.begin() + static_cast<std::ptrdiff_t>(offset), layoutDimensions, row);
+    }
+    row += static_cast<std::ptrdiff_t>(layoutDimensions);
+  });
+  return positions;
+}
+}
@@ -23,15 +23,25 @@
 // Created by andrew on 10/23/25.
 //
 
-#include <pybind11/pybind11.h>
+#if CASET_WITH_TORCH
 #include <torch/torch.h>
+#endif
 #include "Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <exception>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <thread>
 #include "spacetime/Spacetime.h"
 
 namespace caset {
+#if CASET_WITH_TORCH
 void Spacetime::embedEuclidean(int dimensions = 4, double epsilon = 1e-8) {
-  pybind11::gil_scoped_release no_gil;
   if (vertexList->size() == 0) return;
   if (edgeList->size() == 0) return;
 
@@ -52,14 +62,16 @@ void Spacetime::embedEuclidean(int dimensions = 4, double epsilon = 1e-8) {
   }
 
   CLOG(INFO_LEVEL, "Embedding a ", dimensions, "-d Euclidean space with ", N, " vertices and ", E, " edges.");
-  std::unordered_map<std::uint64_t, int> vertexIdToIndex;
-  vertexIdToIndex.reserve(vertexVector.size());
-  std::unordered_map<std::uint64_t, double> vertexIdToTime;
-  vertexIdToTime.reserve(vertexVector.size());
+  // Vertex IDs are dense, so these are indexed by ID directly; -1 marks tombstoned IDs.
+  std::vector<int> vertexIdToIndex(vertexList->idBound(), -1);
+  std::vector<double> vertexIdToTime(vertexList->idBound(), 0.);
   for (int i = 0; i < static_cast<int>(vertexVector.size()); ++i) {
     vertexIdToIndex[vertexVector[i]->getId()] = i;
     vertexIdToTime[vertexVector[i]->getId()] = vertexVector[i]->getTime();
   }
+  const auto indexOf = [&](const IdType id) {
+    return id < vertexIdToIndex.size() ? vertexIdToIndex[id] : -1;
+  };
 
   std::vector<int64_t> edgeIdxToSourceIndex(E);
   std::vector<int64_t> edgeIdxToTargetIndex(E);
@@ -69,18 +81,16 @@ void Spacetime::embedEuclidean(int dimensions = 4, double epsilon = 1e-8) {
 
   for (int e = 0; e < E; ++e) {
     const auto &edge = edgeVector[e];
-    auto sourceIndexIterator = vertexIdToIndex.find(edge->getSourceId());
-    auto targetIndexIterator = vertexIdToIndex.find(edge->getTargetId());
-    if (sourceIndexIterator == vertexIdToIndex.end() || targetIndexIterator == vertexIdToIndex.end()) {
+    const int sourceIndex = indexOf(edge->getSourceId());
+    const int targetIndex = indexOf(edge->getTargetId());
+    if (sourceIndex < 0 || targetIndex < 0) {
       throw std::runtime_error("Edge refers to unknown vertex id");
     }
-    auto sourceTimeIterator = vertexIdToTime.find(edge->getSourceId());
-    auto targetTimeIterator = vertexIdToTime.find(edge->getTargetId());
 
-    edgeIdxToSourceIndex[e] = sourceIndexIterator->second;
-    edgeIdxToTargetIndex[e] = targetIndexIterator->second;
-    edgeIdxToSourceTime[e] = sourceTimeIterator->second;
-    edgeIdxToTargetTime[e] = targetTimeIterator->second;
+    edgeIdxToSourceIndex[e] = sourceIndex;
+    edgeIdxToTargetIndex[e] = targetIndex;
+    edgeIdxToSourceTime[e] = vertexIdToTime[edge->getSourceId()];
+    edgeIdxToTargetTime[e] = vertexIdToTime[edge->getTargetId()];
 
     double L = edge->getSquaredLength();
     // If you have Minkowski lengths and want magnitude-only, use std::abs(L).
@@ -143,8 +153,8 @@ void Spacetime::embedEuclidean(int dimensions = 4, double epsilon = 1e-8) {
     auto sqdist = observedLengths.pow(2).sum(-1); // (E,)
 
     // The observed time is the 0th element of the coordinate vector
-    auto observedSrcTimes = srcPositions.index({torch::arange(0, E), 0});
-    auto observedTgtTimes = tgtPositions.index({torch::arange(0, E), 0});
+    auto observedSrcTimes = srcPositions.select(1, 0);
+    auto observedTgtTimes = tgtPositions.select(1, 0);
     auto observedTimes = (observedSrcTimes + observedTgtTimes) / 2.; // (E,)
 
     auto sqtime = (observedTimes - expectedTimes).pow(2); // (E,)
@@ -184,26 +194,571 @@ void Spacetime::embedEuclidean(int dimensions = 4, double epsilon = 1e-8) {
        " Previous Loss: ",
        previousLoss.item<double>());
 }
+#else
+void Spacetime::embedEuclidean(int dimensions = 4, double epsilon = 1e-8) {
+  EmbeddingOptions options{};
+  options.dimensions = dimensions;
+  options.epsilon = epsilon;
+  embed(options);
+  const std::vector<double> positions = getLayoutArray();
+  auto row = positions.begin();
+  vertexList->forEach([&](const VertexPtr &vertex) {
+    vertex->setCoordinates({row, row + dimensions});
+    row += dimensions;
+  });
+}
+#endif
 
 void Spacetime::build(int numSimplices) {
   // TODO: Implement topologies instead of the default.
   // return topology->build(this);
   std::vector<std::tuple<uint8_t, uint8_t> > orientations = {{1, 2}, {2, 1}};
-  createSimplex(orientations[1]);
-  for (int i = 0; i < numSimplices; i++) {
-    SimplexPtr rightSimplex = createSimplex(orientations[i % 2]);
-    OptionalSimplexPair leftFaceRightFace = chooseSimplexFacesToGlue(rightSimplex);
-    if (!leftFaceRightFace.has_value()) return;
-    auto [leftFace, rightFace] = leftFaceRightFace.value();
-    auto [left, succeeded] = causallyAttachFaces(leftFace, rightFace);
+  std::vector<std::tuple<uint8_t, uint8_t> > schedule{};
+  schedule.reserve(numSimplices + 1);
+  schedule.push_back(orientations[1]);
+  for (int i = 0; i < numSimplices; i++) schedule.push_back(orientations[i % 2]);
+  buildBulk(schedule);
+}
+
+BuildStats Spacetime::buildBulk(const std::vector<std::tuple<uint8_t, uint8_t> > &schedule, Progress *progress) {
+  BuildStats stats{};
+  if (schedule.empty()) return stats;
+
+  // Each glued simplex adds at most one vertex and the edges from it, while it and its facets all stay alive. Vertex
+  // IDs are never reused, so the VertexList grows by every vertex created, glued or not.
+  std::size_t maxVertices = 0;
+  std::size_t vertexIds = 0;
+  for (const auto &[ti, tf] : schedule) {
+    maxVertices = std::max<std::size_t>(maxVertices, ti + tf);
+    vertexIds += ti + tf;
+  }
+  const std::size_t n = schedule.size();
+  reserve(vertexList->size() + n + maxVertices,
+          edgeList->size() + n * maxVertices + Simplex::computeNumberOfEdges(maxVertices),
+          simplexPool->size() + n * (maxVertices + 1));
+  vertexList->reserve(vertexList->idBound() + vertexIds);
+  edgeList->reserve(edgeList->size() + n * maxVertices);
+
+  using Clock = std::chrono::steady_clock;
+  const auto secondsSince = [](const Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  };
+
+  std::size_t i = 0;
+  if (externalSimplices.empty()) {
+    const auto start = Clock::now();
+    createSimplex(schedule[i++]);
+    stats.createSeconds += secondsSince(start);
+    stats.created++;
+  }
+  for (; i < n; i++) {
+    if (progress != nullptr && progress->isCancelled()) break;
+    auto start = Clock::now();
+    const SimplexPtr simplex = createSimplex(schedule[i]);
+    stats.createSeconds += secondsSince(start);
+    stats.created++;
+
+    start = Clock::now();
+    const OptionalSimplexPair faces = chooseSimplexFacesToGlue(simplex);
+    stats.chooseSeconds += secondsSince(start);
+    if (!faces.has_value()) {
+      CLOG(WARN_LEVEL, "No gluable faces for simplex ", i, " of ", n, ". Stopping the build.");
+      stats.unmatched++;
+      break;
+    }
+
+    start = Clock::now();
+    const auto [attached, succeeded] = causallyAttachFaces(faces->first, faces->second);
+    stats.attachSeconds += secondsSince(start);
+    if (succeeded) {
+      stats.glued++;
+      if (progress != nullptr) progress->glued.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      stats.rejected++;
+    }
+  }
+  return stats;
+}
+
+BuildStats Spacetime::buildSlabs(
+  const std::vector<std::tuple<uint8_t, uint8_t> > &schedule,
+  const std::size_t slabs,
+  std::size_t threads,
+  Progress *progress
+) {
+  BuildStats stats{};
+  if (schedule.empty() || slabs == 0) return stats;
+  if (vertexList->size() != 0 || !externalSimplices.empty()) {
+    throw std::logic_error("buildSlabs needs an empty Spacetime");
+  }
+
+  // After the first simplex, each one glued in 2D adds one vertex: a (2, 1) to the lower slice, a (1, 2) to the upper.
+  std::size_t lowerVertices = 0, upperVertices = 0, idsPerSlab = 0;
+  for (std::size_t i = 0; i < schedule.size(); i++) {
+    const auto [ti, tf] = schedule[i];
+    if (ti + tf != 3 || ti == 0 || tf == 0) {
+      throw std::invalid_argument("buildSlabs only supports schedules of (1, 2) and (2, 1) simplices");
+    }
+    if (i == 0) {
+      lowerVertices += ti;
+      upperVertices += tf;
+    } else if (ti == 2) {
+      lowerVertices++;
+    } else {
+      upperVertices++;
+    }
+    idsPerSlab += ti + tf;
+  }
+  if (slabs > 1 && lowerVertices != upperVertices) {
+    throw std::invalid_argument("schedule leaves " + std::to_string(lowerVertices) + " vertices on the lower slice and " +
+                                std::to_string(upperVertices) + " on the upper one, so slabs can't be stitched");
+  }
+
+  struct Slab {
+    std::unique_ptr<Spacetime> spacetime;
+    BuildStats stats{};
+    Vertices lower{};
+    Vertices upper{};
+    std::exception_ptr error{};
+  };
+  std::vector<Slab> built(slabs);
+  for (std::size_t i = 0; i < slabs; i++) {
+    auto slab = std::make_unique<Spacetime>(metric, spacetimeType, alpha, topology);
+    slab->currentTime = currentTime + i;
+    slab->vertexIdCounter = vertexIdCounter + i * idsPerSlab;
+    slab->vertexList = std::make_shared<VertexList>(slab->vertexPool, slab->vertexIdCounter);
+    slab->seed(rng());
+    built[i].spacetime = std::move(slab);
+  }
+
+  std::atomic<std::size_t> next{0};
+  const auto work = [&] {
+    for (std::size_t i = next++; i < slabs; i = next++) {
+      Slab &slab = built[i];
+      try {
+        slab.stats = slab.spacetime->buildBulk(schedule, progress);
+        if (progress != nullptr && progress->isCancelled()) continue;
+        if (slab.stats.unmatched != 0) throw std::runtime_error("slab " + std::to_string(i) + " could not be built");
+        slab.lower = slab.spacetime->walkSlice(static_cast<double>(slab.spacetime->currentTime));
+        slab.upper = slab.spacetime->walkSlice(static_cast<double>(slab.spacetime->currentTime + 1));
+      } catch (...) {
+        slab.error = std::current_exception();
+      }
+    }
+  };
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, slabs);
+  std::vector<std::thread> workers{};
+  workers.reserve(threads - 1);
+  for (std::size_t i = 1; i < threads; i++) workers.emplace_back(work);
+  work();
+  for (auto &worker : workers) worker.join();
+  for (const auto &slab : built) {
+    if (slab.error) std::rethrow_exception(slab.error);
+  }
+  if (progress != nullptr && progress->isCancelled()) return stats;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (auto &slab : built) {
+    absorb(*slab.spacetime);
+    stats.created += slab.stats.created;
+    stats.glued += slab.stats.glued;
+    stats.rejected += slab.stats.rejected;
+    stats.createSeconds += slab.stats.createSeconds;
+    stats.chooseSeconds += slab.stats.chooseSeconds;
+    stats.attachSeconds += slab.stats.attachSeconds;
+  }
+  for (std::size_t i = 0; i + 1 < slabs; i++) stitchSlice(built[i].upper, built[i + 1].lower);
+  stats.mergeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return stats;
+}
+
+void Spacetime::absorb(Spacetime &slab) {
+  vertexPool->absorb(*slab.vertexPool);
+  edgePool->absorb(*slab.edgePool);
+  simplexPool->absorb(*slab.simplexPool);
+
+  vertexList->absorb(*slab.vertexList);
+  const Edges edges = slab.edgeList->toVector();
+  edgeList->reserve(edgeList->size() + edges.size());
+  for (const auto &edge : edges) edgeList->add(edge);
+  slab.edgeList->clear();
+
+  for (const auto &[orientation, bucket] : slab.externalSimplices) {
+    auto &mine = externalSimplices[orientation];
+    mine.reserve(mine.size() + bucket.size());
+    for (const auto &simplex : bucket) mine.insert(simplex);
   }
+  for (const auto &[orientation, bucket] : slab.internalSimplices) {
+    internalSimplices[orientation].insert(bucket.begin(), bucket.end());
+  }
+  for (const auto &[key, bucket] : slab.freeFacets) {
+    auto &mine = freeFacets[key];
+    mine.reserve(mine.size() + bucket.size());
+    for (const auto &facet : bucket) mine.insert(facet);
+  }
+  if (faceCounts.size() < slab.faceCounts.size()) faceCounts.resize(slab.faceCounts.size(), 0);
+  for (std::size_t k = 0; k < slab.faceCounts.size(); k++) faceCounts[k] += slab.faceCounts[k];
+  for (const auto &[orientation, count] : slab.orientationCounts) orientationCounts[orientation] += count;
+  slab.externalSimplices.clear();
+  slab.internalSimplices.clear();
+  slab.freeFacets.clear();
+  slab.faceCounts.clear();
+  slab.orientationCounts.clear();
+  // Stitching doesn't keep the sites up to date; they're indexed again when next needed.
+  for (auto &sites : moveSites) sites.clear();
+  siteSimplexSize = 0;
+  vertexIdCounter = std::max(vertexIdCounter, slab.vertexIdCounter);
+}
+
+namespace {
+///
+/// The copies of one pool's records, found by the original's handle so that the lookup is an index. Records that
+/// weren't allocated from the pool fall back to a map.
+template<typename T>
+class CopyMap {
+  public:
+    explicit CopyMap(const Pool<T> &pool_) : pool(&pool_), copies(pool_.capacity()) {
+    }
+
+    std::shared_ptr<T> &operator[](const T &original) {
+      if (original.getPool() == pool && original.getHandle().index() < copies.size()) {
+        return copies[original.getHandle().index()];
+      }
+      return unpooled[&original];
+    }
+
+  private:
+    const Pool<T> *pool;
+    std::vector<std::shared_ptr<T> > copies;
+    std::unordered_map<const T *, std::shared_ptr<T> > unpooled{};
+};
+}
+
+std::shared_ptr<Spacetime> Spacetime::clone() const {
+  auto copy = std::make_shared<Spacetime>(metric, spacetimeType, alpha, topology);
+  copy->vertexIdCounter = vertexIdCounter;
+  copy->currentTime = currentTime;
+  copy->rng = rng;
+  copy->faceCounts = faceCounts;
+  copy->orientationCounts = orientationCounts;
+  // Sites are stored by vertex ID, which the copy keeps.
+  copy->moveSites = moveSites;
+  copy->siteSimplexSize = siteSimplexSize;
+  copy->observables = observables;
+  copy->vertexPool->reserve(vertexPool->size());
+  copy->edgePool->reserve(edgePool->size());
+  copy->simplexPool->reserve(simplexPool->size());
+
+  CopyMap<Vertex> vertices(*vertexPool);
+  const auto vertexOf = [&](const VertexPtr &original) -> const VertexPtr & {
+    auto &vertex = vertices[*original];
+    if (!vertex) {
+      vertex = makePooled<Vertex>(copy->vertexPool.get(), original->getId(), original->getCoordinatesOrEmpty());
+    }
+    return vertex;
+  };
+  CopyMap<Edge> edges(*edgePool);
+  const auto edgeOf = [&](const EdgePtr &original) -> const EdgePtr & {
+    auto &edge = edges[*original];
+    if (!edge) {
+      edge = makePooled<Edge>(copy->edgePool.get(), original->getSourceId(), original->getTargetId(),
+                              original->getSquaredLength());
+    }
+    return edge;
+  };
+  CopyMap<Simplex> simplices(*simplexPool);
+  Simplices originals{};
+  originals.reserve(simplexPool->size());
+  const auto simplexOf = [&](const SimplexPtr &original) -> const SimplexPtr & {
+    auto &simplex = simplices[*original];
+    if (!simplex) {
+      Vertices simplexVertices{};
+      simplexVertices.reserve(original->vertices.size());
+      for (const auto &vertex : original->vertices) simplexVertices.push_back(vertexOf(vertex));
+      Edges simplexEdges{};
+      simplexEdges.reserve(original->edges.size());
+      for (const auto &edge : original->edges) simplexEdges.push_back(edgeOf(edge));
+      simplex = makePooled<Simplex>(copy->simplexPool.get(), std::move(simplexVertices), std::move(simplexEdges),
+                                    original->orientation);
+      simplex->fingerprint = original->fingerprint;
+      simplex->freeFacets = original->freeFacets;
+      simplex->vertexIdLookup.reserve(simplex->vertices.size());
+      for (const auto &vertex : simplex->vertices) simplex->vertexIdLookup.emplace(vertex->getId(), vertex);
+      originals.push_back(original);
+    }
+    return simplex;
+  };
+
+  // Vertices keep their IDs and their place in the list, edges their order in each adjacency list and simplices
+  // their order at each vertex, so the copy samples exactly like the original.
+  const VertexList &list = *vertexList;
+  copy->vertexList = std::make_shared<VertexList>(copy->vertexPool, list.getFirstId());
+  copy->vertexList->reserve(list.idBound());
+  for (IdType id = list.getFirstId(); id < list.idBound(); id++) {
+    if (const auto vertex = list.get(id)) copy->vertexList->add(vertexOf(vertex));
+  }
+  const Edges listed = edgeList->toVector();
+  copy->edgeList->reserve(listed.size());
+  for (const auto &edge : listed) copy->edgeList->add(edgeOf(edge));
+  for (const auto &vertex : list.toVector()) {
+    const VertexPtr &target = vertexOf(vertex);
+    for (const auto &edge : vertex->getOutEdges()) target->addOutEdge(edgeOf(edge));
+    for (const auto &edge : vertex->getInEdges()) target->addInEdge(edgeOf(edge));
+    for (const auto &simplex : vertex->getSimplices()) target->addSimplex(simplexOf(simplex));
+  }
+  for (const auto &edge : listed) {
+    const EdgePtr &target = edgeOf(edge);
+    for (const auto &simplex : edge->getSimplices()) target->addSimplex(simplexOf(simplex));
+  }
+  // Facets and cofaces can reach simplices no vertex lists, so this walks until no new ones turn up.
+  for (std::size_t i = 0; i < originals.size(); i++) {
+    const SimplexPtr original = originals[i];
+    const SimplexPtr &target = simplexOf(original);
+    target->facets.reserve(original->facets.size());
+    for (const auto &facet : original->facets) target->facets.push_back(simplexOf(facet));
+    target->cofaces.reserve(original->cofaces.size());
+    for (const auto &coface : original->cofaces) target->cofaces.insert(simplexOf(coface));
+  }
+
+  for (const auto &[orientation, bucket] : externalSimplices) {
+    auto &mine = copy->externalSimplices[orientation];
+    mine.reserve(bucket.size());
+    for (const auto &simplex : bucket) mine.insert(simplexOf(simplex));
+  }
+  for (const auto &[key, bucket] : freeFacets) {
+    auto &mine = copy->freeFacets[key];
+    mine.reserve(bucket.size());
+    for (const auto &facet : bucket) mine.insert(simplexOf(facet));
+  }
+  for (const auto &[orientation, bucket] : internalSimplices) {
+    auto &mine = copy->internalSimplices[orientation];
+    mine.reserve(bucket.size());
+    for (const auto &face : bucket) mine.insert(simplexOf(face));
+  }
+  return copy;
+}
+
+Vertices Spacetime::walkSlice(const double time) const {
+  Vertices slice{};
+  for (const auto &vertex : vertexList->toVector()) {
+    if (vertex->getTime() == time) slice.push_back(vertex);
+  }
+  if (slice.empty()) return slice;
+
+  const auto neighbours = [&](const VertexPtr &vertex) {
+    Vertices result{};
+    for (const auto &edge : vertex->getEdges()) {
+      const IdType other = edge->getSourceId() == vertex->getId() ? edge->getTargetId() : edge->getSourceId();
+      const VertexPtr neighbour = vertexList->get(other);
+      if (neighbour != nullptr && neighbour->getTime() == time) result.push_back(neighbour);
+    }
+    return result;
+  };
+  const auto notAPath = [&] {
+    return std::runtime_error("the slice at t=" + std::to_string(time) + " is not an open path");
+  };
+
+  VertexPtr previous = nullptr;
+  VertexPtr current = nullptr;
+  for (const auto &vertex : slice) {
+    if (neighbours(vertex).size() <= 1) {
+      current = vertex;
+      break;
+    }
+  }
+  if (current == nullptr) throw notAPath();
+
+  Vertices path{current};
+  path.reserve(slice.size());
+  while (true) {
+    const Vertices adjacent = neighbours(current);
+    if (adjacent.size() > 2) throw notAPath();
+    VertexPtr following = nullptr;
+    for (const auto &vertex : adjacent) {
+      if (vertex != previous) following = vertex;
+    }
+    if (following == nullptr) break;
+    if (path.size() == slice.size()) throw notAPath();
+    path.push_back(following);
+    previous = std::exchange(current, following);
+  }
+  if (path.size() != slice.size()) throw notAPath();
+  return path;
+}
+
+void Spacetime::stitchSlice(const Vertices &lower, const Vertices &upper) {
+  if (lower.size() != upper.size()) {
+    throw std::runtime_error("cannot stitch a slice of " + std::to_string(lower.size()) + " vertices to one of " +
+                             std::to_string(upper.size()));
+  }
+  // Edges along the two slices are about to become the same edges, so they have to point the same way.
+  for (std::size_t i = 0; i + 1 < lower.size(); i++) {
+    const EdgePtr lowerEdge = edgeList->get({lower[i]->getId(), lower[i + 1]->getId()});
+    const EdgePtr upperEdge = edgeList->get({upper[i]->getId(), upper[i + 1]->getId()});
+    if (lowerEdge == nullptr || upperEdge == nullptr) throw std::runtime_error("slice vertices are not adjacent");
+    const bool lowerForward = lowerEdge->getSourceId() == lower[i]->getId();
+    const bool upperForward = upperEdge->getSourceId() == upper[i]->getId();
+    if (lowerForward != upperForward) reverseEdge(upperEdge);
+  }
+  for (std::size_t i = 0; i < lower.size(); i++) identifyVertices(upper[i], lower[i]);
+
+  // Each spacelike face along the slice is now held by one simplex on either side.
+  for (std::size_t i = 0; i + 1 < lower.size(); i++) {
+    const IdType other = lower[i + 1]->getId();
+    Simplices faces{};
+    for (const auto &simplex : lower[i]->getSimplices()) {
+      if (simplex->size() == 2 && simplex->hasVertex(other) && simplex->getCofaces().size() == 1) {
+        faces.push_back(simplex);
+      }
+    }
+    if (faces.size() == 2) sealFace(faces[0], faces[1]);
+  }
+}
+
+void Spacetime::identifyVertices(const VertexPtr &from, const VertexPtr &to) {
+  SiteList sites{};
+  if (siteSimplexSize != 0) collectSitesAround({from}, sites);
+  from->moveEdgesTo(to, edgeList, vertexList);
+  // replaceVertex removes each simplex from `from`, so walk a copy.
+  const Simplices simplices = from->getSimplices();
+  const std::vector<bool> internal = unfileRenamed(simplices);
+  for (const auto &simplex : simplices) simplex->replaceVertex(from, to);
+  refileRenamed(simplices, internal);
+  vertexList->remove(from);
+  if (siteSimplexSize != 0) {
+    collectSitesAround({to}, sites);
+    refreshSites(sites);
+  }
+}
+
+std::vector<bool> Spacetime::unfileRenamed(const Simplices &simplices) {
+  std::vector<bool> internal{};
+  internal.reserve(simplices.size());
+  for (const auto &simplex : simplices) internal.push_back(forgetInternal(simplex));
+  return internal;
+}
+
+void Spacetime::refileRenamed(const Simplices &simplices, const std::vector<bool> &internal) {
+  // A neighbour glued across a facet holds the renamed simplex in its own copy of that facet, so those co-face sets
+  // need re-bucketing too.
+  Simplices stale{};
+  for (const auto &simplex : simplices) {
+    stale.push_back(simplex);
+    for (const auto &facet : simplex->facets) {
+      stale.push_back(facet);
+      for (const auto &coface : facet->cofaces) {
+        stale.insert(stale.end(), coface->facets.begin(), coface->facets.end());
+      }
+    }
+  }
+  for (const auto &simplex : stale) simplex->rehashCofaces();
+  for (std::size_t i = 0; i < simplices.size(); i++) {
+    if (internal[i]) recordInternal(simplices[i]);
+  }
+}
+
+void Spacetime::reverseEdge(const EdgePtr &edge) {
+  const VertexPtr source = vertexList->get(edge->getSourceId());
+  const VertexPtr target = vertexList->get(edge->getTargetId());
+  source->removeOutEdge(edge);
+  target->removeInEdge(edge);
+  edgeList->remove(edge);
+  edge->reverse();
+  edgeList->add(edge);
+  target->addOutEdge(edge);
+  source->addInEdge(edge);
+}
+
+void Spacetime::reserve(std::size_t vertices, std::size_t edges, std::size_t simplices) {
+  vertexPool->reserve(vertices);
+  edgePool->reserve(edges);
+  simplexPool->reserve(simplices);
+}
+
+void Spacetime::compact() {
+  // Everything is renumbered from a mapping that's checked in full first, so a dangling reference throws before any
+  // ID has changed rather than leaving the Spacetime half renumbered.
+  const std::vector<IdType> remap = vertexList->compactMapping();
+  const auto renumber = [&](const IdType id) {
+    if (id >= remap.size() || remap[id] == VertexList::kRemoved) {
+      throw std::runtime_error("compact: an edge or simplex refers to removed vertex " + std::to_string(id));
+    }
+    return remap[id];
+  };
+
+  // Every simplex (facets included) is registered with each of its vertices.
+  std::unordered_set<Simplex *> seenSimplices{};
+  Simplices simplices{};
+  vertexList->forEach([&](const VertexPtr &vertex) {
+    for (const auto &simplex : vertex->getSimplices()) {
+      if (seenSimplices.insert(simplex.get()).second) simplices.push_back(simplex);
+    }
+  });
+
+  // A simplex can hold an Edge the EdgeList has since replaced with an equal one, so renumber every distinct Edge
+  // object, not just the indexed ones. Indexed edges are keyed by their endpoints and get re-indexed afterwards.
+  const Edges indexedEdges = edgeList->toVector();
+  std::unordered_set<Edge *> seenEdges{};
+  std::vector<std::tuple<EdgePtr, IdType, IdType> > renumbered{};
+  const auto renumberEdge = [&](const EdgePtr &edge) {
+    if (!seenEdges.insert(edge.get()).second) return;
+    renumbered.emplace_back(edge, renumber(edge->getSourceId()), renumber(edge->getTargetId()));
+  };
+  for (const auto &edge : indexedEdges) renumberEdge(edge);
+  for (const auto &simplex : simplices) {
+    for (const auto &edge : simplex->getEdges()) renumberEdge(edge);
+  }
+
+  vertexList->compact();
+  for (const auto &[edge, source, target] : renumbered) {
+    edge->replaceSourceVertex(source);
+    edge->replaceTargetVertex(target);
+  }
+  edgeList->clear();
+  for (const auto &edge : indexedEdges) edgeList->add(edge);
+
+  for (const auto &simplex : simplices) simplex->refreshVertexIds();
+  // Fingerprints changed, so anything bucketed by them needs rebuilding once they're all up to date.
+  for (const auto &simplex : simplices) simplex->rehashCofaces();
+  // externalSimplices is keyed by identity, so only the internal buckets need it.
+  for (auto &bucket : internalSimplices | std::views::values) {
+    SimplexSet rehashed{};
+    rehashed.reserve(bucket.size());
+    for (const auto &simplex : bucket) rehashed.insert(simplex);
+    bucket = std::move(rehashed);
+  }
+  if (siteSimplexSize != 0) indexMoveSites();
+
+  if (layoutDimensions != 0) {
+    std::vector<double> moved(vertexList->size() * layoutDimensions, std::numeric_limits<double>::quiet_NaN());
+    for (IdType id = 0; id < remap.size() && (id + 1) * layoutDimensions <= layout.size(); id++) {
+      if (remap[id] == VertexList::kRemoved) continue;
+      std::copy_n(layout.begin() + static_cast<std::ptrdiff_t>(id * layoutDimensions), layoutDimensions,
+                  moved.begin() + static_cast<std::ptrdiff_t>(remap[id] * layoutDimensions));
+    }
+    layout = std::move(moved);
+    layoutSignatures.clear();
+  }
+
+  vertexIdCounter = vertexList->size();
+}
+
+namespace {
+/// @return n choose k.
+std::int64_t choose(const std::size_t n, const std::size_t k) noexcept {
+  if (k > n) return 0;
+  std::int64_t result = 1;
+  for (std::size_t i = 1; i <= k; i++) result = result * static_cast<std::int64_t>(n - k + i) / static_cast<std::int64_t>(i);
+  return result;
+}
 }
 
 EdgePtr Spacetime::createEdge(
   const std::uint64_t src,
   const std::uint64_t tgt
 ) {
-  EdgePtr edge = edgeList->add(src, tgt);
+  EdgePtr edge = edgeList->add(src, tgt, rng);
   vertexList->get(src)->addOutEdge(edge);
   vertexList->get(tgt)->addInEdge(edge);
   return edge;
@@ -225,10 +780,21 @@ SimplexPtr Spacetime::createSimplex(
 ) {
   const SimplexOrientationPtr orientation = SimplexOrientation::orientationOf(vertices);
 
-  SimplexPtr simplex = Simplex::create(vertices, edges);
-  for (const auto &o : simplex->getOrientation()->getFacialOrientations()) {
-    externalSimplices[o].insert(simplex);
-    externalSimplices[o->flip()].insert(simplex); // TODO: Remove the flipped orientation once attached.
+  SimplexPtr simplex = Simplex::create(vertices, edges, simplexPool.get());
+  addToBoundary(simplex);
+  registerFreeFacets(simplex);
+  if (faceCounts.size() < vertices.size()) faceCounts.resize(vertices.size(), 0);
+  for (std::size_t size = 3; size <= vertices.size(); size++) countFaces(size, choose(vertices.size(), size));
+  countOrientation(simplex, 1);
+  if (siteSimplexSize != 0) {
+    if (vertices.size() > siteSimplexSize) {
+      // The top dimension changed, and with it every site's criterion.
+      indexMoveSites();
+    } else {
+      SiteList sites{};
+      collectSites({simplex}, sites);
+      refreshSites(sites);
+    }
   }
   return simplex;
 }
@@ -305,8 +871,8 @@ SimplexPtr Spacetime::createSimplex(const std::tuple<uint8_t, uint8_t> &numericO
 
 [[nodiscard]] OptionalSimplexPair
 Spacetime::getGluableFaces(const SimplexPtr &unattachedSimplex, const SimplexPtr &attachedSimplex) {
-  auto unattachedFacets = unattachedSimplex->getFacets(); // vector<shared_ptr<Simplex>>
-  auto attachedFacets = attachedSimplex->getFacets();
+  const auto &unattachedFacets = unattachedSimplex->getFacets();
+  const auto &attachedFacets = attachedSimplex->getFacets();
 #if CASET_DEBUG
   for (const auto &f : unattachedFacets) {
     f->validate();
@@ -338,7 +904,8 @@ Spacetime::getGluableFaces(const SimplexPtr &unattachedSimplex, const SimplexPtr
 }
 
 void Spacetime::moveInEdgesFromVertex(const VertexPtr &from, const VertexPtr &to) {
-  for (const auto &edge : from->getInEdges()) {
+  const Vertex::Adjacency inEdges = from->getInEdges();
+  for (const auto &edge : inEdges) {
     // The source is external to the face/simplex, the `from` node is going to be going away.
     const VertexPtr originalSource = vertexList->get(edge->getSourceId());
     originalSource->removeOutEdge(edge);
@@ -352,7 +919,8 @@ void Spacetime::moveInEdgesFromVertex(const VertexPtr &from, const VertexPtr &to
 }
 
 void Spacetime::moveOutEdgesFromVertex(const VertexPtr &from, const VertexPtr &to) {
-  for (const auto &edge : from->getOutEdges()) {
+  const Vertex::Adjacency outEdges = from->getOutEdges();
+  for (const auto &edge : outEdges) {
     const VertexPtr originalTarget = vertexList->get(edge->getTargetId());
     originalTarget->removeInEdge(edge);
     from->removeOutEdge(edge);
@@ -461,53 +1029,712 @@ std::tuple<SimplexPtr, bool> Spacetime::causallyAttachFaces(
   }
 
   const Vertices &attachedOrderedVertices = attachedOrderedVerticesOptional.value();
+  std::size_t shared = 0;
   for (auto i = 0; i < attachedOrderedVertices.size(); i++) {
     std::pair<VertexPtr, VertexPtr> vp = std::make_pair(unattachedVertices[i], attachedOrderedVertices[i]);
+    if (vp.first == vp.second) shared++;
     vertexPairs.push_back(vp);
   }
 
-  for (const auto &facialOrientation : attachedFace->getOrientation()->getFacialOrientations()) {
-    externalSimplices[facialOrientation].erase(attachedFace);
-    externalSimplices[facialOrientation->flip()].erase(attachedFace);
+  // Gluing renames the unattached side's vertices, in every simplex at them, so anything keyed by their
+  // fingerprints is taken out first and filed again afterwards.
+  Simplices renamed{};
+  for (const auto &[unattachedVertex, attachedVertex] : vertexPairs) {
+    if (unattachedVertex == attachedVertex) continue;
+    const auto &simplices = unattachedVertex->getSimplices();
+    renamed.insert(renamed.end(), simplices.begin(), simplices.end());
   }
+  const std::vector<bool> internal = unfileRenamed(renamed);
+  SiteList sites{};
+  if (siteSimplexSize != 0) collectSitesAround(unattachedVertices, sites);
 
   attachAtVertices(unattachedFace, attachedFace, vertexPairs);
+  refileRenamed(renamed, internal);
 
-  if (!unattachedFace->getCofaces().empty()) {
-    for (const auto &newCoface : unattachedFace->getCofaces()) {
-      attachedFace->addCoface(newCoface);
-    }
-  }
+  sealFace(attachedFace, unattachedFace);
 
-  if (!attachedFace->isCausallyAvailable()) {
-    internalSimplices[attachedFace->getOrientation()].insert(attachedFace);
-    internalSimplices[attachedFace->getOrientation()->flip()].insert(attachedFace);
+  if (siteSimplexSize != 0) {
+    collectSitesAround(attachedOrderedVertices, sites);
+    refreshSites(sites);
   }
 
+  // Every face of unattachedFace is now the matching face of attachedFace, unless all its vertices already were.
+  const std::size_t size = attachedOrderedVertices.size();
+  for (std::size_t k = 3; k <= size; k++) countFaces(k, choose(shared, k) - choose(size, k));
+
+  if (!attachedFace->isCausallyAvailable()) recordInternal(attachedFace);
+
   return {attachedFace, true};
 }
 
 OptionalSimplexPair Spacetime::chooseSimplexFacesToGlue(const SimplexPtr &unattachedSimplex) {
-  for (const auto &facialOrientation : unattachedSimplex->getGluableFaceOrientations()) {
-    const auto &prospectiveCofaces = externalSimplices[facialOrientation];
-    if (prospectiveCofaces.empty()) continue;
-    for (auto attachedCofaceId = prospectiveCofaces.begin(); attachedCofaceId != prospectiveCofaces.end(); ++
-         attachedCofaceId) {
-      if ((*attachedCofaceId)->fingerprint.fingerprint() == unattachedSimplex->fingerprint.fingerprint()) continue;
-      if (!unattachedSimplex->hasCausallyAvailableFacet() || !(*attachedCofaceId)->hasCausallyAvailableFacet()) continue;
+  const Simplex::FacetMask free = unattachedSimplex->getFreeFacets();
+  if (free == 0) return std::nullopt;
+  // Uniform draws before falling back to a scan. Draws only miss when they land on one of unattachedSimplex's own
+  // facets, which is only likely while the complex is tiny.
+  constexpr std::size_t kMaxDraws = 8;
+  const auto fingerprint = unattachedSimplex->fingerprint.fingerprint();
+  // A free facet has exactly one coface: the simplex it belongs to.
+  const auto isPartner = [&](const SimplexPtr &candidate) {
+    const auto &cofaces = candidate->getCofaces();
+    return cofaces.size() == 1 && (*cofaces.begin())->fingerprint.fingerprint() != fingerprint;
+  };
+
+  // The facets are tried in order, so which face of the new simplex is glued is deterministic; only its partner is
+  // drawn.
+  const auto &facets = unattachedSimplex->getFacets();
+  for (std::size_t i = 0; i < facets.size(); ++i) {
+    if (!unattachedSimplex->isFacetFree(i)) continue;
+    const SimplexPtr &unattachedFace = facets[i];
+    const auto key = facetKeyOf(unattachedFace);
+    if (!key.has_value()) continue;
+    const auto bucket = freeFacets.find(*key);
+    if (bucket == freeFacets.end() || bucket->second.empty()) continue;
+    const auto &candidates = bucket->second;
 #if CASET_DEBUG
-      (*attachedCofaceId)->validate();
+    unattachedFace->validate();
 #endif
-      OptionalSimplexPair gluablePair = getGluableFaces(unattachedSimplex, *attachedCofaceId);
-      if (gluablePair.has_value()) {
-        const auto &[unattachedFace, attachedFace] = gluablePair.value();
-        return gluablePair;
-      }
+
+    for (std::size_t draw = 0; draw < kMaxDraws; ++draw) {
+      const SimplexPtr &attachedFace = candidates.sample(rng);
+      if (isPartner(attachedFace)) return std::make_optional(std::make_pair(unattachedFace, attachedFace));
+    }
+    const std::size_t n = candidates.size();
+    const std::size_t offset = rng.below(n);
+    for (std::size_t c = 0; c < n; ++c) {
+      const SimplexPtr &attachedFace = candidates[(offset + c) % n];
+      if (isPartner(attachedFace)) return std::make_optional(std::make_pair(unattachedFace, attachedFace));
     }
   }
   return std::nullopt;
 }
 
+std::optional<Spacetime::FacetKey> Spacetime::facetKeyOf(const SimplexPtr &facet) {
+  const auto [ti, tf] = facet->getOrientation()->numeric();
+  if (ti == 0 || tf == 0) return std::nullopt;
+  double time = std::numeric_limits<double>::max();
+  for (const auto &vertex : facet->getVertices()) time = std::min(time, vertex->getTime());
+  return FacetKey{ti, tf, facet->isTimelike(), static_cast<std::uint64_t>(time)};
+}
+
+void Spacetime::registerFreeFacets(const SimplexPtr &simplex) {
+  const auto &facets = simplex->getFacets();
+  for (std::size_t i = 0; i < facets.size(); ++i) {
+    if (!simplex->isFacetFree(i)) continue;
+    if (const auto key = facetKeyOf(facets[i])) freeFacets[*key].insert(facets[i]);
+  }
+}
+
+void Spacetime::sealFace(const SimplexPtr &attachedFace, const SimplexPtr &unattachedFace) {
+  for (const auto &newCoface : unattachedFace->getCofaces()) {
+    attachedFace->addCoface(newCoface);
+  }
+  // Both faces now share a fingerprint. Only the simplices on either side of it lost a free facet, so only they can
+  // have left the boundary.
+  if (const auto key = facetKeyOf(attachedFace)) {
+    if (const auto bucket = freeFacets.find(*key); bucket != freeFacets.end()) {
+      bucket->second.erase(attachedFace);
+      bucket->second.erase(unattachedFace);
+    }
+  }
+  for (const auto &coface : attachedFace->getCofaces()) {
+    if (const auto i = coface->findFacet(attachedFace)) coface->markFacetGlued(*i);
+    if (coface->getFreeFacets() == 0) removeFromBoundary(coface);
+  }
+}
+
+void Spacetime::removeFromBoundary(const SimplexPtr &simplex) {
+  for (const auto &o : simplex->getOrientation()->getFacialOrientations()) {
+    if (const auto bucket = externalSimplices.find(o); bucket != externalSimplices.end()) bucket->second.erase(simplex);
+    if (const auto bucket = externalSimplices.find(o->flip()); bucket != externalSimplices.end()) {
+      bucket->second.erase(simplex);
+    }
+  }
+}
+
+void Spacetime::addToBoundary(const SimplexPtr &simplex) {
+  for (const auto &o : simplex->getOrientation()->getFacialOrientations()) {
+    externalSimplices[o].insert(simplex);
+    externalSimplices[o->flip()].insert(simplex); // TODO: Remove the flipped orientation once attached.
+  }
+}
+
+namespace {
+/// @return Whether the vertices span exactly two neighbouring slices, as every simplex of a causal complex must.
+bool spansOneSlab(const Vertices &vertices) {
+  double earliest = std::numeric_limits<double>::max();
+  double latest = std::numeric_limits<double>::lowest();
+  for (const auto &vertex : vertices) {
+    earliest = std::min(earliest, vertex->getTime());
+    latest = std::max(latest, vertex->getTime());
+  }
+  return latest - earliest == 1.;
+}
+
+bool onOneSlice(const Vertices &vertices) {
+  return std::ranges::all_of(vertices, [&](const VertexPtr &v) { return v->getTime() == vertices[0]->getTime(); });
+}
+
+bool contains(const Vertices &vertices, const VertexPtr &vertex) {
+  return std::ranges::find(vertices, vertex) != vertices.end();
+}
+
+/// The move a face of `size` vertices is a candidate site for, and the order it needs to be one, if any. `slice` and
+/// `slab` say whether the face lies on one slice or spans one slab. See `Spacetime::countMoveSites`.
+std::optional<std::pair<MoveType, std::size_t> > siteKind(const std::size_t size, const bool slice, const bool slab,
+                                                           const std::size_t d) noexcept {
+  if (size == 0 || size > d) return std::nullopt;
+  if (slice) return std::pair{size == d ? MoveType::Add : size == 1 ? MoveType::Remove : MoveType::Flip, 2 * (d + 1 - size)};
+  if (slab && size > 1) return std::pair{size == d ? MoveType::Shift : MoveType::Ishift, d + 2 - size};
+  return std::nullopt;
+}
+}
+
+VertexPtr Spacetime::insertVertex(const Vertices &face) {
+  if (face.empty() || !onOneSlice(face) || topSizeAt(face[0]) != face.size() + 1) return nullptr;
+  const Simplices star = simplicesContaining(face, face.size() + 1);
+  if (star.size() != 2) return nullptr;
+  const double time = face[0]->getTime();
+  Vertices cones{};
+  for (const auto &simplex : star) {
+    for (const auto &vertex : simplex->getVertices()) {
+      if (!contains(face, vertex)) cones.push_back(vertex);
+    }
+  }
+  // One simplex above the slice and one below.
+  if (cones.size() != 2 || cones[0]->getTime() + cones[1]->getTime() != 2 * time || cones[0]->getTime() == time) {
+    return nullptr;
+  }
+  const VertexPtr vertex = vertexList->add(vertexIdCounter++, {time});
+  exchangeStar(face, {vertex}, cones, star);
+  return vertex;
+}
+
+bool Spacetime::removeVertex(const VertexPtr &vertex) {
+  if (vertex == nullptr || !vertexList->contains(vertex->getId())) return false;
+  return flipSpatialFace({vertex});
+}
+
+bool Spacetime::flipSpatialFace(const Vertices &face) {
+  if (face.empty() || !onOneSlice(face)) return false;
+  const std::size_t size = topSizeAt(face[0]);
+  const Simplices star = simplicesContaining(face, size);
+  if (star.empty()) return false;
+  const double time = face[0]->getTime();
+  Vertices b{};
+  Vertices cones{};
+  for (const auto &simplex : star) {
+    std::size_t offSlice = 0;
+    for (const auto &vertex : simplex->getVertices()) {
+      if (vertex->getTime() != time) {
+        offSlice++;
+        if (!contains(cones, vertex)) cones.push_back(vertex);
+      } else if (!contains(face, vertex) && !contains(b, vertex)) {
+        b.push_back(vertex);
+      }
+    }
+    // Only (d, 1) and (1, d) simplices are coned off a spatial simplex.
+    if (offSlice != 1) return false;
+  }
+  if (cones.size() != 2 || cones[0]->getTime() + cones[1]->getTime() != 2 * time) return false;
+  // The star is A * dB * {above, below} exactly when it has every one of those simplices.
+  if (face.size() + b.size() != size || star.size() != 2 * b.size()) return false;
+  // B must not already be a face, or the slice would stop being a manifold.
+  if (!simplicesContaining(b, size).empty()) return false;
+  if (b.size() == 2 && edgeList->get({b[0]->getId(), b[1]->getId()}) != nullptr) return false;
+  // Removing a vertex drops all of its edges, which must all be in the star.
+  if (face.size() == 1 && face[0]->degree() != b.size() + cones.size()) return false;
+  exchangeStar(face, b, cones, star);
+  return true;
+}
+
+bool Spacetime::flipTimelikeFace(const Vertices &face) {
+  if (face.size() < 2 || !spansOneSlab(face)) return false;
+  const std::size_t size = topSizeAt(face[0]);
+  const Simplices star = simplicesContaining(face, size);
+  // A Pachner move at a face of |A| vertices replaces a star of d + 2 - |A| simplices.
+  if (star.size() < 2 || star.size() + face.size() != size + 1) return false;
+  Vertices b{};
+  for (const auto &simplex : star) {
+    for (const auto &vertex : simplex->getVertices()) {
+      if (!contains(face, vertex) && !contains(b, vertex)) b.push_back(vertex);
+    }
+  }
+  if (b.size() != star.size() || !spansOneSlab(b)) return false;
+  if (!simplicesContaining(b, size).empty()) return false;
+  if (b.size() == 2 && edgeList->get({b[0]->getId(), b[1]->getId()}) != nullptr) return false;
+  // B + (A - a) must be a causal simplex for every a.
+  for (const auto &skipped : face) {
+    Vertices replacement = b;
+    for (const auto &vertex : face) {
+      if (vertex != skipped) replacement.push_back(vertex);
+    }
+    if (!spansOneSlab(replacement)) return false;
+  }
+  exchangeStar(face, b, {}, star);
+  return true;
+}
+
+std::size_t Spacetime::countMoveSites(const MoveType move) {
+  if (siteSimplexSize == 0) indexMoveSites();
+  return moveSites[static_cast<std::size_t>(move)].size();
+}
+
+std::optional<Vertices> Spacetime::sampleMoveSite(const MoveType move, Rng &generator) {
+  if (siteSimplexSize == 0) indexMoveSites();
+  const auto &sites = moveSites[static_cast<std::size_t>(move)];
+  if (sites.empty()) return std::nullopt;
+  const SimplexFingerprint &site = sites.sample(generator);
+  Vertices vertices{};
+  vertices.reserve(site.ids().size());
+  for (const IdType id : site.ids()) vertices.push_back(vertexList->get(id));
+  return vertices;
+}
+
+CountChange Spacetime::countChange(const MoveType move, const Vertices &site) const {
+  const std::size_t size = getDimension() + 1;
+  const std::size_t d = size - 1;
+  const Simplices star = simplicesContaining(site, size);
+  const bool onSlice = move == MoveType::Add || move == MoveType::Remove || move == MoveType::Flip;
+  if (site.empty()) return {};
+
+  // The star's vertices, A first, then B, then the cones, each a bit of a mask. Add's new vertex is the only one in B,
+  // and has no Vertex yet.
+  const std::size_t k = site.size();
+  Vertices vertices = site;
+  Vertices cones{};
+  for (const auto &simplex : star) {
+    for (const auto &vertex : simplex->getVertices()) {
+      if (contains(vertices, vertex) || contains(cones, vertex)) continue;
+      if (onSlice && vertex->getTime() != site[0]->getTime()) cones.push_back(vertex);
+      else vertices.push_back(vertex);
+    }
+  }
+  if (move == MoveType::Add) vertices.push_back(nullptr);
+  const std::size_t coneStart = vertices.size();
+  vertices.insert(vertices.end(), cones.begin(), cones.end());
+  using Mask = std::uint64_t;
+  if (vertices.size() > 64) return {};
+  const auto bit = [](const std::size_t i) { return Mask{1} << i; };
+  const Mask a = bit(k) - 1;
+  const Mask b = (bit(coneStart) - 1) & ~a;
+  const Mask created = move == MoveType::Add ? bit(coneStart - 1) : 0;
+  const auto timeOf = [&](const std::size_t i) {
+    return vertices[i] == nullptr ? site[0]->getTime() : vertices[i]->getTime();
+  };
+
+  std::vector<Mask> removed{};
+  for (const auto &simplex : star) {
+    Mask mask = 0;
+    for (const auto &vertex : simplex->getVertices()) {
+      mask |= bit(static_cast<std::size_t>(std::ranges::find(vertices, vertex) - vertices.begin()));
+    }
+    removed.push_back(mask);
+  }
+  std::vector<Mask> added{};
+  for (std::size_t i = 0; i < k; i++) {
+    const Mask replacement = b | (a & ~bit(i));
+    if (cones.empty()) added.push_back(replacement);
+    for (std::size_t c = coneStart; c < vertices.size(); c++) added.push_back(replacement | bit(c));
+  }
+
+  // The earliest time among a mask's vertices, how many are on it, and the latest.
+  const auto shape = [&](const Mask mask) {
+    double earliest = std::numeric_limits<double>::max();
+    double latest = std::numeric_limits<double>::lowest();
+    for (std::size_t i = 0; i < vertices.size(); i++) {
+      if (mask & bit(i)) {
+        earliest = std::min(earliest, timeOf(i));
+        latest = std::max(latest, timeOf(i));
+      }
+    }
+    std::size_t onEarliest = 0;
+    for (std::size_t i = 0; i < vertices.size(); i++) onEarliest += (mask & bit(i)) && timeOf(i) == earliest;
+    return std::tuple{earliest, onEarliest, latest};
+  };
+  const auto spatialCones = [&](const std::vector<Mask> &simplices) {
+    return std::ranges::count_if(simplices, [&](const Mask simplex) {
+      const auto [earliest, onEarliest, latest] = shape(simplex);
+      return onEarliest == 1 || onEarliest == d;
+    });
+  };
+  const auto kindOf = [&](const Mask face) {
+    const auto [earliest, onEarliest, latest] = shape(face);
+    return siteKind(std::popcount(face), latest == earliest, latest - earliest == 1., d);
+  };
+  const auto spanned = [](const std::vector<Mask> &simplices) {
+    return std::popcount(std::accumulate(simplices.begin(), simplices.end(), Mask{0}, std::bit_or{}));
+  };
+
+  CountChange change{
+    spanned(added) - spanned(removed),
+    static_cast<std::int64_t>(added.size()) - static_cast<std::int64_t>(removed.size()),
+    spatialCones(added) - spatialCones(removed),
+    0
+  };
+
+  // The inverse is the move at B. Only faces of the old and new simplices change order, so its sites are recounted
+  // among those.
+  const auto inverse = kindOf(b);
+  if (!inverse) return change;
+  std::vector<Mask> faces{};
+  for (const auto *simplices : {&removed, &added}) {
+    for (const Mask simplex : *simplices) {
+      for (Mask face = simplex; face != 0; face = (face - 1) & simplex) faces.push_back(face);
+    }
+  }
+  std::ranges::sort(faces);
+  faces.erase(std::ranges::unique(faces).begin(), faces.end());
+  const auto containing = [](const std::vector<Mask> &simplices, const Mask face) {
+    return std::ranges::count_if(simplices, [&](const Mask simplex) { return (simplex & face) == face; });
+  };
+  Vertices face{};
+  for (const Mask mask : faces) {
+    const auto kind = kindOf(mask);
+    if (!kind || kind->first != inverse->first) continue;
+    std::int64_t before = 0;
+    if ((mask & created) == 0) {
+      face.clear();
+      for (std::size_t i = 0; i < vertices.size(); i++) {
+        if (mask & bit(i)) face.push_back(vertices[i]);
+      }
+      before = static_cast<std::int64_t>(countSimplicesContaining(face, size));
+    }
+    const std::int64_t after = before - containing(removed, mask) + containing(added, mask);
+    const auto order = static_cast<std::int64_t>(kind->second);
+    change.inverseSites += (after == order) - (before == order);
+  }
+  return change;
+}
+
+void Spacetime::indexMoveSites() {
+  for (auto &sites : moveSites) sites.clear();
+  siteSimplexSize = std::max<std::size_t>(faceCounts.size(), 1);
+  SiteList all{};
+  for (const auto &vertex : vertexList->toVector()) collectSitesAround({vertex}, all);
+  refreshSites(all);
+}
+
+void Spacetime::collectSites(const Simplices &simplices, SiteList &sites) const {
+  std::vector<IdType> ids{};
+  for (const auto &simplex : simplices) {
+    if (simplex->size() != siteSimplexSize) continue;
+    const auto &vertices = simplex->getVertices();
+    // Every proper face; the simplex itself is never a site.
+    for (std::uint32_t mask = 1; mask + 1 < 1u << vertices.size(); mask++) {
+      ids.clear();
+      for (std::size_t i = 0; i < vertices.size(); i++) {
+        if (mask >> i & 1u) ids.push_back(vertices[i]->getId());
+      }
+      sites.emplace_back(ids);
+    }
+  }
+}
+
+void Spacetime::collectSitesAround(const Vertices &vertices, SiteList &sites) const {
+  for (const auto &vertex : vertices) collectSites(vertex->getSimplices(), sites);
+}
+
+void Spacetime::refreshSites(SiteList &sites) {
+  std::ranges::sort(sites, [](const SimplexFingerprint &a, const SimplexFingerprint &b) {
+    return a.fingerprint() < b.fingerprint();
+  });
+  sites.erase(std::unique(sites.begin(), sites.end()), sites.end());
+  const std::size_t d = siteSimplexSize - 1;
+  Vertices face{};
+  for (const auto &site : sites) {
+    face.clear();
+    for (const IdType id : site.ids()) {
+      const VertexPtr vertex = vertexList->get(id);
+      if (vertex == nullptr) break;
+      face.push_back(vertex);
+    }
+    if (face.size() != site.ids().size()) {
+      // A vertex of the face has gone, and the face with it.
+      for (auto &candidates : moveSites) candidates.erase(site);
+      continue;
+    }
+    const auto kind = siteKind(face.size(), onOneSlice(face), spansOneSlab(face), d);
+    if (!kind) continue;
+    const auto &[move, order] = *kind;
+    auto &candidates = moveSites[static_cast<std::size_t>(move)];
+    if (countSimplicesContaining(face, siteSimplexSize) == order) candidates.insert(site);
+    else candidates.erase(site);
+  }
+}
+
+void Spacetime::exchangeStar(const Vertices &a, const Vertices &b, const Vertices &cones, const Simplices &star) {
+  // Facets shared by two simplices of the star disappear with it. The rest bound the star, and whatever is on the
+  // other side of them is glued to the replacement.
+  std::unordered_map<std::uint64_t, std::size_t> facetCounts{};
+  for (const auto &simplex : star) {
+    for (const auto &facet : simplex->getFacets()) facetCounts[facet->fingerprint.fingerprint()]++;
+  }
+  std::unordered_map<std::uint64_t, SimplexPtr> across{};
+  for (const auto &simplex : star) {
+    for (const auto &facet : simplex->getFacets()) {
+      const auto fingerprint = facet->fingerprint.fingerprint();
+      if (facetCounts[fingerprint] > 1) continue;
+      SimplexPtr neighbour = nullptr;
+      for (const auto &candidate : simplicesContaining(facet->getVertices(), simplex->size())) {
+        if (std::ranges::find(star, candidate) == star.end()) neighbour = candidate;
+      }
+      across.emplace(fingerprint, neighbour);
+    }
+  }
+  SiteList sites{};
+  if (siteSimplexSize != 0) collectSites(star, sites);
+  for (const auto &simplex : star) {
+    retireSimplex(simplex, across);
+    countOrientation(simplex, -1);
+  }
+
+  // The faces that go are A + S + c, for every proper subset S of B and at most one cone vertex c. The faces that
+  // arrive are the same with A and B swapped.
+  const auto facesContaining = [&](const std::size_t core, const std::size_t rest, const std::size_t size) {
+    std::int64_t faces = 0;
+    for (std::size_t s = 0; s < rest && core + s <= size; s++) {
+      const std::size_t apex = size - core - s;
+      if (apex == 0) faces += choose(rest, s);
+      else if (apex == 1) faces += choose(rest, s) * static_cast<std::int64_t>(cones.size());
+    }
+    return faces;
+  };
+  for (std::size_t size = 3; size <= star.front()->size(); size++) {
+    countFaces(size, facesContaining(b.size(), a.size(), size) - facesContaining(a.size(), b.size(), size));
+  }
+
+  if (a.size() == 2) {
+    removeEdge(edgeList->get({a[0]->getId(), a[1]->getId()}));
+  } else if (a.size() == 1) {
+    const Vertex::Adjacency in = a[0]->getInEdges();
+    const Vertex::Adjacency out = a[0]->getOutEdges();
+    for (const auto &edge : in) removeEdge(edge);
+    for (const auto &edge : out) removeEdge(edge);
+    vertexList->remove(a[0]);
+  }
+
+  std::vector<Vertices> replacements{};
+  const std::size_t apexes = std::max<std::size_t>(cones.size(), 1);
+  replacements.reserve(a.size() * apexes);
+  for (const auto &skipped : a) {
+    for (std::size_t c = 0; c < apexes; c++) {
+      Vertices vertices = b;
+      for (const auto &vertex : a) {
+        if (vertex != skipped) vertices.push_back(vertex);
+      }
+      if (!cones.empty()) vertices.push_back(cones[c]);
+      // Earlier slice first, as `createSimplex` orders them.
+      std::ranges::sort(vertices, [](const VertexPtr &x, const VertexPtr &y) {
+        return std::make_pair(x->getTime(), x->getId()) < std::make_pair(y->getTime(), y->getId());
+      });
+      replacements.push_back(std::move(vertices));
+    }
+  }
+
+  // New edges are the ones containing B: the edge B itself, or every edge of a new vertex.
+  for (const auto &vertices : replacements) {
+    for (std::size_t i = 0; i < vertices.size(); i++) {
+      for (std::size_t j = i + 1; j < vertices.size(); j++) {
+        const IdType source = vertices[i]->getId();
+        const IdType target = vertices[j]->getId();
+        if (edgeList->get({source, target}) != nullptr) continue;
+        createEdge(source, target, squaredLengthBetween(vertices[i], vertices[j]));
+      }
+    }
+  }
+
+  Simplices created{};
+  created.reserve(replacements.size());
+  std::unordered_map<std::uint64_t, std::pair<SimplexPtr, std::size_t> > inner{};
+  for (const auto &vertices : replacements) {
+    Edges edges{};
+    edges.reserve(Simplex::computeNumberOfEdges(vertices.size()));
+    for (std::size_t i = 0; i < vertices.size(); i++) {
+      for (std::size_t j = i + 1; j < vertices.size(); j++) {
+        edges.push_back(edgeList->get({vertices[i]->getId(), vertices[j]->getId()}));
+      }
+    }
+    const SimplexPtr simplex = Simplex::create(vertices, edges, simplexPool.get());
+    const auto &facets = simplex->getFacets();
+    for (std::size_t i = 0; i < facets.size(); i++) {
+      const auto fingerprint = facets[i]->fingerprint.fingerprint();
+      if (const auto outside = across.find(fingerprint); outside != across.end()) {
+        if (outside->second != nullptr) glueFacet(simplex, i, outside->second);
+      } else if (const auto sibling = inner.find(fingerprint); sibling != inner.end()) {
+        glueFacet(simplex, i, sibling->second.first);
+      } else {
+        inner.emplace(fingerprint, std::make_pair(simplex, i));
+      }
+    }
+    created.push_back(simplex);
+  }
+  for (const auto &simplex : created) {
+    registerFreeFacets(simplex);
+    if (simplex->getFreeFacets() != 0) addToBoundary(simplex);
+    countOrientation(simplex, 1);
+  }
+  if (siteSimplexSize != 0) {
+    collectSites(created, sites);
+    refreshSites(sites);
+  }
+}
+
+void Spacetime::retireSimplex(const SimplexPtr &simplex,
+                              const std::unordered_map<std::uint64_t, SimplexPtr> &across) {
+  removeFromBoundary(simplex);
+  const auto &facets = simplex->getFacets();
+  for (std::size_t i = 0; i < facets.size(); i++) {
+    const SimplexPtr &facet = facets[i];
+    if (simplex->isFacetFree(i)) {
+      if (const auto key = facetKeyOf(facet)) {
+        if (const auto bucket = freeFacets.find(*key); bucket != freeFacets.end()) bucket->second.erase(facet);
+      }
+    }
+    forgetInternal(facet);
+    if (const auto outside = across.find(facet->fingerprint.fingerprint());
+      outside != across.end() && outside->second != nullptr) {
+      const SimplexPtr &neighbour = outside->second;
+      if (const auto j = neighbour->findFacet(facet)) {
+        // Gluing renames vertices of simplices already in co-face sets, so re-bucket before erasing.
+        neighbour->facets[*j]->rehashCofaces();
+        neighbour->facets[*j]->cofaces.erase(simplex);
+      }
+    }
+    for (const auto &vertex : facet->getVertices()) vertex->removeSimplex(facet);
+    // Facets and their cofaces own each other.
+    facet->cofaces.clear();
+  }
+  for (const auto &vertex : simplex->getVertices()) vertex->removeSimplex(simplex);
+  simplex->facets.clear();
+}
+
+void Spacetime::glueFacet(const SimplexPtr &simplex, const std::size_t i, const SimplexPtr &neighbour) {
+  const SimplexPtr &facet = simplex->getFacets()[i];
+  const auto j = neighbour->findFacet(facet);
+  if (!j.has_value()) throw std::logic_error("neighbour does not share the facet " + facet->toString());
+  const SimplexPtr &theirs = neighbour->getFacets()[*j];
+  facet->addCoface(neighbour);
+  theirs->addCoface(simplex);
+  simplex->markFacetGlued(i);
+  neighbour->markFacetGlued(*j);
+  forgetInternal(facet);
+  recordInternal(facet);
+}
+
+void Spacetime::recordInternal(const SimplexPtr &face) {
+  internalSimplices[face->getOrientation()].insert(face);
+  internalSimplices[face->getOrientation()->flip()].insert(face);
+}
+
+bool Spacetime::forgetInternal(const SimplexPtr &face) {
+  bool erased = false;
+  for (const auto &o : {face->getOrientation(), face->getOrientation()->flip()}) {
+    if (const auto bucket = internalSimplices.find(o); bucket != internalSimplices.end()) {
+      erased = bucket->second.erase(face) > 0 || erased;
+    }
+  }
+  return erased;
+}
+
+void Spacetime::countFaces(const std::size_t size, const std::int64_t delta) {
+  if (faceCounts.size() < size) faceCounts.resize(size, 0);
+  faceCounts[size - 1] = static_cast<std::size_t>(static_cast<std::int64_t>(faceCounts[size - 1]) + delta);
+}
+
+void Spacetime::countOrientation(const SimplexPtr &simplex, const std::int64_t delta) {
+  std::size_t &count = orientationCounts[simplex->getOrientation()->fingerprint()];
+  count = static_cast<std::size_t>(static_cast<std::int64_t>(count) + delta);
+}
+
+std::size_t Spacetime::getFaceCount(const std::size_t k) const noexcept {
+  if (k == 0) return vertexList->size();
+  if (k == 1) return edgeList->size();
+  return k < faceCounts.size() ? faceCounts[k] : 0;
+}
+
+std::vector<std::size_t> Spacetime::getFVector() const {
+  const std::size_t dimension = getDimension();
+  std::vector<std::size_t> fVector{};
+  fVector.reserve(dimension + 1);
+  for (std::size_t k = 0; k <= dimension; k++) fVector.push_back(getFaceCount(k));
+  return fVector;
+}
+
+std::size_t Spacetime::getSimplexCount(const std::tuple<uint8_t, uint8_t> &orientation) const noexcept {
+  const auto count = orientationCounts.find(
+    SimplexOrientation(std::get<0>(orientation), std::get<1>(orientation)).fingerprint());
+  return count == orientationCounts.end() ? 0 : count->second;
+}
+
+std::int64_t Spacetime::getEulerCharacteristic() const noexcept {
+  std::int64_t chi = 0;
+  const std::size_t dimension = getDimension();
+  for (std::size_t k = 0; k <= dimension; k++) {
+    const auto faces = static_cast<std::int64_t>(getFaceCount(k));
+    chi += k % 2 == 0 ? faces : -faces;
+  }
+  return chi;
+}
+
+double Spacetime::action(const double kappa0, const double delta, const double kappa4) const noexcept {
+  const std::size_t dimension = getDimension();
+  const auto d = static_cast<uint8_t>(dimension);
+  const CountChange counts{
+    static_cast<std::int64_t>(getFaceCount(0)),
+    static_cast<std::int64_t>(getFaceCount(dimension)),
+    static_cast<std::int64_t>(getSimplexCount({d, 1}) + getSimplexCount({1, d}))
+  };
+  return actionChange(counts, kappa0, delta, kappa4);
+}
+
+double Spacetime::actionChange(const CountChange &change, const double kappa0, const double delta,
+                               const double kappa4) noexcept {
+  return -(kappa0 + 6. * delta) * static_cast<double>(change.vertices) +
+         (kappa4 + delta) * static_cast<double>(change.simplices) +
+         delta * static_cast<double>(change.spatialCones);
+}
+
+Simplices Spacetime::simplicesContaining(const Vertices &face, const std::size_t size) {
+  Simplices result{};
+  if (face.empty()) return result;
+  for (const auto &simplex : face[0]->getSimplices()) {
+    if (simplex->size() != size) continue;
+    if (std::ranges::all_of(face, [&](const VertexPtr &v) { return contains(simplex->getVertices(), v); })) {
+      result.push_back(simplex);
+    }
+  }
+  return result;
+}
+
+std::size_t Spacetime::countSimplicesContaining(const Vertices &face, const std::size_t size) noexcept {
+  if (face.empty()) return 0;
+  return std::ranges::count_if(face[0]->getSimplices(), [&](const SimplexPtr &simplex) {
+    return simplex->size() == size &&
+           std::ranges::all_of(face, [&](const VertexPtr &v) { return contains(simplex->getVertices(), v); });
+  });
+}
+
+std::size_t Spacetime::topSizeAt(const VertexPtr &vertex) noexcept {
+  std::size_t size = 0;
+  for (const auto &simplex : vertex->getSimplices()) size = std::max(size, simplex->size());
+  return size;
+}
+
+double Spacetime::squaredLengthBetween(const VertexPtr &a, const VertexPtr &b) const {
+  if (a->getTime() != b->getTime() && metric->getSignature()->getSignatureType() == SignatureType::Lorentzian) {
+    return -alpha;
+  }
+  return alpha;
+}
+
+void Spacetime::removeEdge(const EdgePtr &edge) {
+  if (edge == nullptr) return;
+  if (const VertexPtr source = vertexList->get(edge->getSourceId())) source->removeOutEdge(edge);
+  if (const VertexPtr target = vertexList->get(edge->getTargetId())) target->removeInEdge(edge);
+  edgeList->remove(edge);
+}
+
 SimplexSet Spacetime::getExternalSimplices() noexcept {
   SimplexSet simplices{};
   for (const auto &[facialOrientation, bucket] : externalSimplices) {
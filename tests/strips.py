@@ -0,0 +1,37 @@
+# MIT License
+# Copyright (c) 2025 Andrew Kelleher
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""The 2D strip most tests build: alternating (2, 1) and (1, 2) triangles, capped at both ends."""
+
+from caset import Spacetime
+
+
+def schedule(pairs=10):
+    """One slice of the strip, with `pairs` (1, 2)/(2, 1) pairs between its caps."""
+    return [(2, 1)] + [(1, 2), (2, 1)] * pairs + [(1, 2)]
+
+
+def strip(pairs=10, slabs=4, seed=5, stream=0):
+    """A seeded `Spacetime` holding `slabs` copies of `schedule(pairs)` stitched together."""
+    st = Spacetime()
+    st.seed(seed, stream)
+    st.buildSlabs(schedule(pairs), slabs=slabs)
+    return st
@@ -0,0 +1,146 @@
+# MIT License
+# Copyright (c) 2025 Andrew Kelleher
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+
+import unittest
+
+import math
+
+from caset import CDT, Philox
+
+from .strips import strip
+
+
+class TestCDT(unittest.TestCase):
+
+    def test_add_then_remove_restores_counts(self):
+        st = strip(pairs=20)
+        cdt = CDT(st)
+        cdt.seed(1)
+        vertices = st.getVertexList().size()
+        edges = st.getEdgeList().size()
+        triangles = st.getFaceCount(2)
+
+        while not cdt.add():
+            pass
+        self.assertEqual(st.getVertexList().size(), vertices + 1)
+        self.assertEqual(st.getEdgeList().size(), edges + 3)
+        self.assertEqual(st.getFVector(), [vertices + 1, edges + 3, triangles + 2])
+
+        stats = cdt.getStats(CDT.Move.Add)
+        self.assertGreaterEqual(stats.attempted, 1)
+        self.assertEqual(stats.accepted, 1)
+
+    def test_sweep_keeps_the_strip_connected(self):
+        st = strip(pairs=20)
+        cdt = CDT(st)
+        cdt.seed(2)
+        accepted = cdt.sweep(2000)
+
+        moves = [CDT.Move.Add, CDT.Move.Remove, CDT.Move.Flip, CDT.Move.Shift, CDT.Move.Ishift]
+        self.assertEqual(sum(cdt.getStats(move).attempted for move in moves), 2000)
+        self.assertEqual(sum(cdt.getStats(move).accepted for move in moves), accepted)
+        # There are no spatial Pachner moves on a 1D slice, and the (2, 2) move is its own inverse.
+        self.assertEqual(cdt.getStats(CDT.Move.Flip).attempted, 0)
+        self.assertEqual(cdt.getStats(CDT.Move.Ishift).attempted, 0)
+        self.assertEqual(len(st.getConnectedComponents()), 1)
+        self.assertEqual(st.getEulerCharacteristic(), 1)
+        for simplex in st.getSimplices():
+            simplex.validate()
+
+        cdt.resetStats()
+        self.assertEqual(cdt.getStats(CDT.Move.Shift).attempted, 0)
+
+    def test_proposal_probability_follows_the_site_counts(self):
+        st = strip(pairs=20)
+        cdt = CDT(st)
+        cdt.seed(3)
+        cdt.sweep(500)
+
+        for move in [CDT.Move.Add, CDT.Move.Remove, CDT.Move.Shift]:
+            sites = st.countMoveSites(move)
+            self.assertGreater(sites, 0)
+            self.assertAlmostEqual(cdt.proposalProbability(move), 1. / (3 * sites))
+        for move in [CDT.Move.Flip, CDT.Move.Ishift]:
+            self.assertEqual(st.countMoveSites(move), 0)
+            self.assertEqual(cdt.proposalProbability(move), 0.)
+
+    def test_couplings_weight_the_moves(self):
+        st = strip(pairs=20)
+        cdt = CDT(st)
+        cdt.seed(4)
+        self.assertIsNone(cdt.getCouplings())
+        vertices = st.getVertexList().size()
+
+        couplings = CDT.Couplings(kappa0=0., delta=0., kappa4=10.)
+        cdt.setCouplings(couplings)
+        self.assertEqual(cdt.getCouplings().kappa4, 10.)
+        self.assertAlmostEqual(cdt.action(couplings), 10. * st.getFaceCount(2))
+
+        # Every add costs two triangles, so at this cosmological constant none gets through.
+        cdt.sweep(1000)
+        self.assertEqual(cdt.getStats(CDT.Move.Add).accepted, 0)
+        self.assertGreater(cdt.getStats(CDT.Move.Remove).accepted, 0)
+        self.assertLess(st.getVertexList().size(), vertices)
+        self.assertEqual(st.getEulerCharacteristic(), 1)
+
+    def test_acceptance_ratio_counts_the_inverse_after_the_move(self):
+        st = strip(pairs=20)
+        cdt = CDT(st)
+        cdt.seed(6)
+        cdt.sweep(500)
+        couplings = CDT.Couplings(kappa0=.3, delta=.2, kappa4=1.1)
+        cdt.setCouplings(couplings)
+        generator = Philox(7)
+        inverses = {CDT.Move.Add: CDT.Move.Remove, CDT.Move.Remove: CDT.Move.Add, CDT.Move.Shift: CDT.Move.Shift}
+        makes = {
+            CDT.Move.Add: lambda site: st.insertVertex(site) is not None,
+            CDT.Move.Remove: lambda site: st.removeVertex(site[0]),
+            CDT.Move.Shift: st.flipTimelikeFace,
+        }
+
+        checked, notOneMore = 0, 0
+        for i in range(300):
+            move = list(inverses)[i % 3]
+            site = st.sampleMoveSite(move, generator)
+            if site is None:
+                continue
+            ratio = cdt.acceptanceRatio(move, site)
+            forward = st.countMoveSites(move)
+            before = st.countMoveSites(inverses[move])
+            action = cdt.action(couplings)
+            if not makes[move](site):
+                continue
+            # Rebuilds the site index from scratch, so the counts below don't rely on the incremental bookkeeping.
+            st.compact()
+            backward = st.countMoveSites(inverses[move])
+            expected = forward / backward * math.exp(action - cdt.action(couplings))
+            self.assertAlmostEqual(ratio, expected, delta=1e-9 * expected)
+            checked += 1
+            if backward != before + 1:
+                notOneMore += 1
+        self.assertGreater(checked, 100)
+        # A move also makes and unmakes inverse sites other than its own, so the count rarely just goes up by one.
+        self.assertGreater(notOneMore, 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,118 @@
+# MIT License
+# Copyright (c) 2025 Andrew Kelleher
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+
+import os
+import tempfile
+import threading
+import unittest
+
+from caset import CDT, ConfigurationLog, ConfigurationReader, EnsembleRunner
+
+from .strips import strip
+
+
+class TestConfigurationLog(unittest.TestCase):
+
+    def test_frames_round_trip(self):
+        st = strip()
+        cdt = CDT(st)
+        cdt.seed(3)
+        expected = []
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, 'configurations.bin')
+            log = ConfigurationLog(path, chunkBytes=512)
+            for sweep in range(10):
+                cdt.sweep(100)
+                log.append(st, sweep=sweep)
+                expected.append((st.getFaceCount(2), st.getSimplexCount((2, 1))))
+            log.close()
+            self.assertEqual(len(log), 10)
+
+            reader = ConfigurationReader(path)
+            self.assertTrue(reader.isComplete())
+            self.assertEqual(len(reader), 10)
+            for i in reversed(range(10)):
+                frame = reader.getFrame(i)
+                self.assertEqual((frame.sweep, frame.chain, frame.width), (i, 0, 3))
+                vertices, orientations = frame.vertices, frame.orientations
+                self.assertEqual(vertices.shape, (expected[i][0], 3))
+                self.assertEqual(orientations.shape, (expected[i][0], 2))
+                self.assertEqual(int(((orientations[:, 0] == 2) & (orientations[:, 1] == 1)).sum()), expected[i][1])
+                self.assertTrue((vertices[:, 1:] > vertices[:, :-1]).all())
+                self.assertEqual(len(set(map(tuple, vertices.tolist()))), expected[i][0])
+            ids = {v.getId() for v in st.getVertexList().toVector()}
+            self.assertTrue(set(frame.vertices.flatten().tolist()) <= ids)
+
+            # Without its index, a log is read up to the last complete chunk.
+            with open(path, 'r+b') as f:
+                f.truncate(os.path.getsize(path) - 40)
+            reader = ConfigurationReader(path)
+            self.assertFalse(reader.isComplete())
+            self.assertEqual(len(reader), 10)
+            self.assertEqual(reader.getFrame(9).vertices.shape, (expected[9][0], 3))
+
+    def test_ensemble_logs_every_chain(self):
+        st = strip()
+        runner = EnsembleRunner([st.clone() for _ in range(3)], threads=2)
+        runner.seed(42)
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, 'configurations.bin')
+            log = ConfigurationLog(path)
+            runner.setConfigurationLog(log, every=5)
+            runner.run(sweeps=20, attempts=50, measureEvery=0)
+            log.close()
+
+            reader = ConfigurationReader(path)
+            self.assertEqual(sorted((reader.getChain(i), reader.getSweep(i)) for i in range(len(reader))),
+                             [(chain, sweep) for chain in range(3) for sweep in (5, 10, 15, 20)])
+            for i in range(len(reader)):
+                if reader.getSweep(i) == 20:
+                    frame = reader.getFrame(i)
+                    self.assertEqual(len(frame.vertices), runner.getChain(frame.chain).getSpacetime().getFaceCount(2))
+
+    def test_concurrent_flushes_all_return(self):
+        st = strip()
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, 'configurations.bin')
+            log = ConfigurationLog(path, queueDepth=2, chunkBytes=64)
+
+            def flusher(chain):
+                for sweep in range(20):
+                    log.append(st, sweep=sweep, chain=chain)
+                    log.flush()
+
+            threads = [threading.Thread(target=flusher, args=(chain,)) for chain in range(4)]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join(timeout=60)
+                self.assertFalse(thread.is_alive())
+            log.close()
+            self.assertEqual(len(ConfigurationReader(path)), 80)
+
+    def test_missing_log_is_refused(self):
+        with self.assertRaises(RuntimeError):
+            ConfigurationReader(os.path.join(tempfile.gettempdir(), 'no-such-caset-log.bin'))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,77 @@
+# MIT License
+# Copyright (c) 2025 Andrew Kelleher
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+
+import unittest
+
+from caset import CDT, EnsembleRunner, SpacetimeVolume
+
+from .strips import strip
+
+
+class TestEnsembleRunner(unittest.TestCase):
+
+    def test_chains_must_not_share_a_spacetime(self):
+        st = strip()
+        with self.assertRaises(ValueError):
+            EnsembleRunner([st, st])
+        with self.assertRaises(ValueError):
+            EnsembleRunner([])
+
+    def test_samples_are_ordered_by_chain_and_sweep(self):
+        st = strip()
+        runner = EnsembleRunner([st.clone() for _ in range(3)], threads=2)
+        runner.addObservable(SpacetimeVolume())
+        runner.setCouplings(CDT.Couplings(kappa0=1., kappa4=0.8))
+        runner.seed(42)
+        runner.run(sweeps=20, attempts=50, measureEvery=5)
+
+        samples = runner.getSamples()
+        self.assertEqual(runner.getThreads(), 2)
+        self.assertEqual(samples.shape, (3 * 4, runner.getSampleWidth()))
+        self.assertEqual([int(row[0]) for row in samples], [0] * 4 + [1] * 4 + [2] * 4)
+        self.assertEqual([int(row[1]) for row in samples[:4]], [5, 10, 15, 20])
+        self.assertTrue((samples[:, 2] > 0).all())
+        self.assertEqual(samples[3][2], runner.getChain(0).getSpacetime().getFaceCount(2))
+
+        summary = runner.summarize()
+        self.assertEqual(summary.samples, 12)
+        self.assertAlmostEqual(summary.mean[0], samples[:, 2].mean())
+
+        with self.assertRaises(RuntimeError):
+            runner.addObservable(SpacetimeVolume())
+        runner.clearSamples()
+        self.assertEqual(runner.summarize().samples, 0)
+
+    def test_results_do_not_depend_on_the_thread_count(self):
+        st = strip()
+        results = []
+        for threads in (1, 3):
+            runner = EnsembleRunner([st.clone() for _ in range(3)], threads=threads)
+            runner.addObservable(SpacetimeVolume())
+            runner.seed(7)
+            runner.run(sweeps=10, attempts=50)
+            results.append(runner.getSamples().tolist())
+        self.assertEqual(results[0], results[1])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,92 @@
+# MIT License
+# Copyright (c) 2025 Andrew Kelleher
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+
+import threading
+import unittest
+
+from caset import Spacetime, CDT, EnsembleRunner, Job
+
+from .strips import schedule, strip
+
+
+class TestJob(unittest.TestCase):
+
+    def test_build_runs_in_the_background(self):
+        st = Spacetime()
+        st.seed(3)
+        rows = schedule(pairs=2000)
+        job = st.buildSlabsAsync(rows, slabs=8)
+        # The GIL is free while the build runs, so this thread and others keep going until it's done.
+        ticks = []
+        ticker = threading.Thread(target=lambda: ticks.extend(range(1000)))
+        ticker.start()
+        polls = 0
+        while not job.isDone():
+            polls += 1
+        ticker.join()
+        self.assertGreater(polls, 0)
+        self.assertTrue(job.wait(timeout=60))
+        job.get()
+
+        progress = job.getProgress()
+        self.assertTrue(progress.done)
+        self.assertFalse(progress.cancelled)
+        self.assertEqual(progress.glued, 8 * len(rows))
+        self.assertEqual(len(ticks), 1000)
+        self.assertEqual(st.getEulerCharacteristic(), 1)
+
+    def test_sampling_can_be_cancelled(self):
+        st = strip(pairs=20, seed=3)
+        chain = CDT(st)
+        chain.seed(1)
+        job = chain.runAsync(sweeps=10 ** 9, attempts=100)
+        self.assertFalse(job.wait(timeout=0.05))
+        job.cancel()
+        self.assertTrue(job.wait(timeout=60))
+        job.get()
+
+        progress = job.getProgress()
+        self.assertTrue(progress.cancelled)
+        self.assertGreater(progress.sweeps, 0)
+        self.assertEqual(progress.attempts, progress.sweeps * 100)
+        self.assertLessEqual(progress.accepted, progress.attempts)
+        self.assertGreater(progress.sweepsPerSecond, 0)
+        self.assertEqual(st.getEulerCharacteristic(), 1)
+
+    def test_ensemble_progress(self):
+        st = strip(pairs=20, seed=3)
+        runner = EnsembleRunner([st.clone() for _ in range(3)], threads=2)
+        runner.seed(4)
+        job = runner.runAsync(sweeps=5, attempts=50)
+        job.get()
+        self.assertEqual(job.getProgress().sweeps, 15)
+
+    def test_errors_are_rethrown(self):
+        st = strip(pairs=0, slabs=1)
+        job = st.buildSlabsAsync(schedule(pairs=0), slabs=1)
+        with self.assertRaises(RuntimeError):
+            job.get()
+        self.assertIsInstance(job, Job)
+
+
+if __name__ == '__main__':
+    unittest.main()
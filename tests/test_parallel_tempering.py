@@ -0,0 +1,67 @@
+# MIT License
+# Copyright (c) 2025 Andrew Kelleher
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+
+import unittest
+
+from caset import CDT, ParallelTempering
+
+from .strips import strip
+
+
+class TestParallelTempering(unittest.TestCase):
+
+    def _replicas(self, count):
+        return [strip(seed=10 + i) for i in range(count)]
+
+    def test_needs_one_replica_per_rung(self):
+        with self.assertRaises(ValueError):
+            ParallelTempering(self._replicas(2), [CDT.Couplings(kappa4=1.)])
+
+    def test_swaps_exchange_couplings(self):
+        replicas = self._replicas(3)
+        ladder = [CDT.Couplings(kappa0=1., kappa4=0.8 + 0.005 * i) for i in range(3)]
+        tempering = ParallelTempering(replicas, ladder)
+        tempering.seed(3)
+        accepted = tempering.run(rounds=40, attempts=50, threads=2)
+
+        self.assertEqual(tempering.getRounds(), 40)
+        # Even and odd pairs take turns, so each pair is proposed every other round.
+        self.assertEqual(tempering.getSwapStats(0).attempted, 20)
+        self.assertEqual(tempering.getSwapStats(1).attempted, 20)
+        self.assertEqual(tempering.getSwapStats(0).accepted + tempering.getSwapStats(1).accepted, accepted)
+        self.assertGreater(accepted, 0)
+
+        # Replicas move between rungs, but each rung keeps its couplings.
+        self.assertEqual(sorted(tempering.getRung(i) for i in range(3)), [0, 1, 2])
+        for i, st in enumerate(replicas):
+            rung = tempering.getRung(i)
+            replica = tempering.getReplicaAt(rung)
+            self.assertIs(replica.getSpacetime(), st)
+            self.assertEqual(replica.getCouplings().kappa4, ladder[rung].kappa4)
+
+        trips = tempering.getRoundTripStats()
+        if trips.completed:
+            self.assertGreaterEqual(trips.meanRounds, 2)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,82 @@
+# MIT License
+# Copyright (c) 2025 Andrew Kelleher
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+
+import unittest
+
+from caset import Philox, Edge
+
+
+class TestPhilox(unittest.TestCase):
+
+    def test_a_seed_reproduces_the_sequence(self):
+        a, b = Philox(42), Philox(42)
+        self.assertEqual([a() for _ in range(5)], [b() for _ in range(5)])
+        self.assertEqual(a, b)
+        self.assertEqual(a.getPosition(), 5)
+
+    def test_streams_are_independent(self):
+        a, b = Philox(42, stream=0), Philox(42, stream=1)
+        self.assertNotEqual([a() for _ in range(4)], [b() for _ in range(4)])
+        self.assertEqual(Philox(42).split(3), Philox(42, 3))
+
+    def test_batches_continue_the_sequence(self):
+        batched, scalar = Philox(7), Philox(7)
+        values = list(batched.uniform(3)) + list(batched.uniform(40))
+        self.assertEqual(values, list(scalar.uniform(43)))
+        self.assertTrue(all(0. <= value < 1. for value in values))
+
+        skipped = Philox(7)
+        skipped.discard(3)
+        self.assertEqual(list(skipped.uniform(40)), values[3:])
+
+    def test_exponential_mean(self):
+        samples = Philox(1).exponential(200000, rate=4.)
+        self.assertTrue((samples >= 0).all())
+        self.assertAlmostEqual(samples.mean(), 0.25, delta=0.005)
+
+    def test_below_is_specified(self):
+        # Pinned, since the point of `below` is that no standard library can change these.
+        a = Philox(42)
+        self.assertEqual([a.below(1000) for _ in range(6)], [468, 340, 327, 454, 658, 773])
+        counts = [0, 0, 0]
+        b = Philox(9)
+        for _ in range(30000):
+            counts[b.below(3)] += 1
+        self.assertTrue(all(abs(count - 10000) < 500 for count in counts))
+
+    def test_normal_moments(self):
+        generator = Philox(3)
+        samples = generator.normal(200000)
+        self.assertAlmostEqual(samples.mean(), 0., delta=0.01)
+        self.assertAlmostEqual(samples.std(), 1., delta=0.01)
+        self.assertEqual(generator.getPosition(), 400000)
+
+    def test_edge_lengths_come_from_the_generator(self):
+        self.assertEqual(Edge(3, 4, Philox(1)).getSquaredLength(), Edge(3, 4, Philox(1)).getSquaredLength())
+        self.assertNotEqual(Edge(3, 4, Philox(1)).getSquaredLength(), Edge(3, 4, Philox(2)).getSquaredLength())
+        self.assertTrue(-1. <= Edge(3, 4, Philox(1)).getSquaredLength() < 1.)
+        # Without a generator an edge is only good for lookups, and draws nothing.
+        self.assertEqual(Edge(3, 4).getSquaredLength(), 0.)
+
+
+if __name__ == '__main__':
+    unittest.main()
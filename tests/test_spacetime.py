@@ -19,9 +19,15 @@
 # OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 # SOFTWARE.
 
+import os
+import tempfile
 import unittest
 
-from caset import Spacetime, Edge, Vertex
+import numpy as np
+
+from caset import Spacetime, Edge, Vertex, CDT
+
+from .strips import schedule, strip
 
 class TestSpacetime(unittest.TestCase):
 
@@ -118,6 +124,112 @@ class TestSpacetime(unittest.TestCase):
         st.embedEuclidean()
         vertices = st.getVertexList().toVector()
 
+    def test_stress_majorization(self):
+        st = strip(pairs=20, slabs=3, seed=3)
+
+        stresses = []
+        for iterations in (0, 10, 100):
+            st.seed(4)
+            stats = st.embed(dimensions=3, maxIterations=iterations, tolerance=0.)
+            self.assertEqual(stats.iterations, iterations)
+            stresses.append(stats.stress)
+        self.assertLess(stresses[1], stresses[0])
+        self.assertLess(stresses[2], stresses[1])
+
+        layout = st.getLayoutArray()
+        self.assertEqual(layout.shape, (len(st.getTimeArray()), 3))
+        self.assertEqual(layout[:, 0].tolist(), st.getTimeArray().tolist())
+        # The layout lives beside the complex, so the moves still see the vertices' times.
+        CDT(st).sweep(100)
+        self.assertEqual(st.getEulerCharacteristic(), 1)
+
+        stats = st.embed(dimensions=3, maxIterations=10 ** 9, tolerance=1e-3)
+        self.assertTrue(stats.converged)
+        self.assertFalse(st.embed(maxIterations=10 ** 9, tolerance=0., timeBudget=0.01).converged)
+
+    def test_embedding_leaves_the_generator_alone(self):
+        embedded, plain = strip(seed=3), strip(seed=3)
+        embedded.embed(dimensions=3, maxIterations=5)
+        first = embedded.getLayoutArray()
+        embedded.embed(dimensions=3, maxIterations=5, seed=8)
+        self.assertNotEqual(first.tolist(), embedded.getLayoutArray().tolist())
+        embedded.embed(dimensions=3, maxIterations=5)
+        self.assertEqual(first.tolist(), embedded.getLayoutArray().tolist())
+
+        # New edges draw their lengths from the Spacetime's generator, which the embeds didn't touch.
+        for st in (embedded, plain):
+            cdt = CDT(st)
+            cdt.seed(1)
+            cdt.sweep(200)
+        self.assertEqual(embedded.getSquaredLengthArray().tolist(), plain.getSquaredLengthArray().tolist())
+
+    def test_same_slice_repulsion(self):
+        st = strip(pairs=100, slabs=3, seed=3)
+
+        def crowding():
+            layout = st.getLayoutArray()
+            close = 0
+            for time in set(layout[:, 0].tolist()):
+                spatial = layout[layout[:, 0] == time, 1:]
+                distances = np.linalg.norm(spatial[:, None, :] - spatial[None, :, :], axis=-1)
+                close += int((distances < 1.).sum()) - len(spatial)
+            return close
+
+        st.seed(4)
+        st.embed(dimensions=3, maxIterations=200, tolerance=0.)
+        without = crowding()
+        st.seed(4)
+        stats = st.embed(dimensions=3, maxIterations=200, tolerance=0., repulsion=1., repulsionCutoff=1.)
+        self.assertEqual(stats.iterations, 200)
+        self.assertLess(crowding(), without / 2)
+
+        # Slices are handed to whichever worker is free, but the layout doesn't depend on how many there are.
+        st.seed(4)
+        one = st.embed(dimensions=3, maxIterations=20, threads=1, repulsion=1.)
+        layout = st.getLayoutArray()
+        st.seed(4)
+        four = st.embed(dimensions=3, maxIterations=20, threads=4, repulsion=1.)
+        self.assertEqual(one.stress, four.stress)
+        self.assertEqual(layout.tolist(), st.getLayoutArray().tolist())
+
+        with self.assertRaises(ValueError):
+            st.embed(repulsion=1., repulsionCutoff=0.)
+
+    def test_incremental_embedding(self):
+        st = strip(pairs=200, seed=3)
+        st.seed(4)
+        full = st.embed(dimensions=3, maxIterations=200)
+        self.assertEqual(full.vertices, len(st.getTimeArray()))
+
+        # Nothing has changed, so there's nothing to refit.
+        stats = st.embed(dimensions=3, incremental=True)
+        self.assertEqual(stats.vertices, 0)
+        self.assertEqual(stats.iterations, 0)
+        self.assertTrue(stats.converged)
+
+        ids = st.getVertexIdArray().tolist()
+        before = dict(zip(ids, st.getLayoutArray().tolist()))
+        cdt = CDT(st)
+        cdt.seed(5)
+        self.assertGreater(cdt.sweep(10), 0)
+        stats = st.embed(dimensions=3, maxIterations=200, incremental=True, hops=1)
+        self.assertGreater(stats.vertices, 0)
+        self.assertLess(stats.vertices, len(st.getTimeArray()) / 4)
+
+        # Vertices away from the moves keep their positions, and new ones are placed among their neighbours.
+        layout = st.getLayoutArray()
+        self.assertFalse(np.isnan(layout).any())
+        kept = sum(1 for id, row in zip(st.getVertexIdArray().tolist(), layout.tolist()) if before.get(id) == row)
+        self.assertEqual(kept, len(st.getTimeArray()) - stats.vertices)
+
+        # The layout follows its vertices through a compaction, though the next incremental embed refits them all.
+        st.compact()
+        self.assertEqual(st.getLayoutArray().tolist(), layout.tolist())
+        self.assertEqual(st.embed(dimensions=3, maxIterations=1, incremental=True).vertices, len(st.getTimeArray()))
+
+        # Without a layout of as many dimensions, it starts over.
+        self.assertEqual(st.embed(dimensions=4, maxIterations=1, incremental=True).vertices, len(st.getTimeArray()))
+
     def test_attaching_faces4D(self):
         st = Spacetime()
 
@@ -715,6 +827,251 @@ class TestSpacetime(unittest.TestCase):
         gluableFaces[0].validate()
         gluableFaces[1].validate()
 
+    def test_handles_resolve_to_records(self):
+        st = Spacetime()
+        simplex = st.createSimplex((2, 1))
+        vertex = simplex.getVertices()[0]
+        edge = simplex.getEdges()[0]
+
+        self.assertIs(st.getVertex(vertex.getHandle()), vertex)
+        self.assertIs(st.getEdge(edge.getHandle()), edge)
+        self.assertIs(st.getSimplex(simplex.getHandle()), simplex)
+
+        # Handles carry their pool's tag, so another Spacetime refuses them rather than resolving an unrelated record.
+        other = Spacetime()
+        other.createSimplex((2, 1))
+        with self.assertRaises(ValueError):
+            other.getVertex(vertex.getHandle())
+        with self.assertRaises(ValueError):
+            st.getEdge(vertex.getHandle())
+
+    def test_compact_renumbers_vertices(self):
+        st = Spacetime()
+        st.build(20)
+        vertexList = st.getVertexList()
+        numVertices = vertexList.size()
+        numEdges = st.getEdgeList().size()
+        self.assertGreater(vertexList.tombstones(), 0)
+        self.assertIsNone(vertexList.get(vertexList.idBound()))
+
+        st.compact()
+
+        self.assertEqual(vertexList.tombstones(), 0)
+        self.assertEqual(vertexList.size(), numVertices)
+        self.assertEqual(sorted(v.getId() for v in vertexList.toVector()), list(range(numVertices)))
+        self.assertEqual(st.getEdgeList().size(), numEdges)
+        for edge in st.getEdgeList().toVector():
+            self.assertTrue(vertexList.contains(edge.getSourceId()))
+            self.assertTrue(vertexList.contains(edge.getTargetId()))
+        for simplex in st.getSimplices():
+            simplex.validate()
+        self.assertEqual(len(st.getConnectedComponents()), 1)
+
+    def test_compact_leaves_a_dangling_spacetime_untouched(self):
+        st = Spacetime()
+        st.build(20)
+        vertexList = st.getVertexList()
+        ids = sorted(v.getId() for v in vertexList.toVector())
+        tombstones = vertexList.tombstones()
+        self.assertGreater(tombstones, 0)
+        st.getEdgeList().add(ids[0], vertexList.idBound() + 5, 1.)
+
+        with self.assertRaises(RuntimeError):
+            st.compact()
+        self.assertEqual(vertexList.tombstones(), tombstones)
+        self.assertEqual(sorted(v.getId() for v in vertexList.toVector()), ids)
+
+    def test_seeded_build_stays_connected(self):
+        for seed in range(3):
+            st = Spacetime()
+            st.seed(seed)
+            st.build(50)
+            self.assertEqual(len(st.getConnectedComponents()), 1)
+            for simplex in st.getSimplices():
+                simplex.validate()
+
+    def test_gluing_marks_facets_glued(self):
+        st = Spacetime()
+        s12 = st.createSimplex((1, 2))
+        s21 = st.createSimplex((2, 1))
+        self.assertEqual(s12.getFreeFacets(), 0b111)
+        self.assertEqual(s21.getFreeFacets(), 0b111)
+
+        leftFace, rightFace = st.chooseSimplexFacesToGlue(s21)
+        _, succeeded = st.causallyAttachFaces(leftFace, rightFace)
+        self.assertTrue(succeeded)
+
+        self.assertEqual(bin(s12.getFreeFacets()).count('1'), 2)
+        self.assertEqual(bin(s21.getFreeFacets()).count('1'), 2)
+
+    def test_build_bulk_glues_schedule(self):
+        st = Spacetime()
+        stats = st.buildBulk([(2, 1)] + [(1, 2), (2, 1)] * 25)
+        self.assertEqual(stats.created, 51)
+        self.assertEqual(stats.glued, 50)
+        self.assertEqual(stats.unmatched, 0)
+        self.assertEqual(stats.rejected, 0)
+        self.assertGreaterEqual(stats.attachSeconds, 0.)
+        self.assertEqual(len(st.getConnectedComponents()), 1)
+
+        with self.assertRaises(ValueError):
+            st.buildBulk([1, 2, 3])
+        # Counts that don't fit a simplex are refused rather than wrapped into a byte.
+        for row in ((300, 1), (2, -1), (0, 2), (5, 9)):
+            with self.assertRaises(ValueError):
+                st.buildBulk([(2, 1), row])
+
+    def test_build_slabs_stitches_slices(self):
+        st = Spacetime()
+        rows = schedule(pairs=20)
+        stats = st.buildSlabs(rows, slabs=4, threads=2)
+        self.assertEqual(stats.created, 4 * len(rows))
+        self.assertEqual(stats.unmatched, 0)
+        self.assertGreaterEqual(stats.mergeSeconds, 0.)
+        self.assertEqual(len(st.getConnectedComponents()), 1)
+        for simplex in st.getSimplices():
+            simplex.validate()
+
+        with self.assertRaises(RuntimeError):
+            st.buildSlabs(rows, slabs=2)
+
+    def test_counts_track_the_build(self):
+        st = Spacetime()
+        st.buildBulk([(2, 1)] + [(1, 2), (2, 1)] * 25)
+        n0, n1, n2 = st.getFVector()
+        self.assertEqual(n0, st.getVertexList().size())
+        self.assertEqual(n1, st.getEdgeList().size())
+        self.assertEqual(n2, 51)
+        self.assertEqual(st.getSimplexCount((2, 1)), 26)
+        self.assertEqual(st.getSimplexCount((1, 2)), 25)
+        self.assertEqual(st.getEulerCharacteristic(), 1)
+        self.assertAlmostEqual(st.action(kappa0=1., delta=0., kappa4=2.), -n0 + 2. * n2)
+        # Every 2D simplex is a (2, 1) or (1, 2), so Delta weighs each of them twice.
+        self.assertAlmostEqual(st.action(kappa0=.5, delta=.25, kappa4=1.5),
+                               -(.5 + 6 * .25) * n0 + (1.5 + .25) * 51 + .25 * 51)
+        self.assertAlmostEqual(st.action(kappa0=0., delta=1., kappa4=0.), -6. * n0 + 2. * 51)
+
+        st = Spacetime()
+        st.buildBulk([(1, 4), (2, 3)] * 20)
+        fVector = st.getFVector()
+        self.assertEqual(len(fVector), 5)
+        self.assertEqual(fVector[4], 40)
+        self.assertEqual(st.getFaceCount(4), 40)
+        self.assertEqual(st.getEulerCharacteristic(), 1)
+        self.assertEqual(st.getSimplexCount((1, 4)), 20)
+        self.assertEqual(st.getSimplexCount((2, 3)), 20)
+        # Delta (2 N4^(4, 1) + N4^(3, 2)) = 2 * 20 + 20.
+        self.assertAlmostEqual(st.action(kappa0=0., delta=1., kappa4=0.), -6. * fVector[0] + 60.)
+        self.assertAlmostEqual(st.action(kappa0=2., delta=.5, kappa4=3.), -(2. + 3.) * fVector[0] + 3. * 40 + .5 * 60)
+
+    def test_clone_is_independent(self):
+        st = strip(slabs=3, seed=3)
+        copy = st.clone()
+
+        self.assertEqual(copy.getFVector(), st.getFVector())
+        self.assertEqual(copy.getSimplexCount((2, 1)), st.getSimplexCount((2, 1)))
+        self.assertEqual(len(copy.getSimplices()), len(st.getSimplices()))
+        ids = sorted(v.getId() for v in st.getVertexList().toVector())
+        self.assertEqual(sorted(v.getId() for v in copy.getVertexList().toVector()), ids)
+        self.assertIsNot(copy.getVertexList().get(ids[0]), st.getVertexList().get(ids[0]))
+
+        # Both chains make the same moves from the same seed...
+        chains = [CDT(st), CDT(copy)]
+        for chain in chains:
+            chain.seed(7)
+        self.assertEqual(chains[0].sweep(500), chains[1].sweep(500))
+        self.assertEqual(copy.getFVector(), st.getFVector())
+
+        # ...and moving one leaves the other alone.
+        fVector = st.getFVector()
+        chains[1].sweep(500)
+        self.assertEqual(st.getFVector(), fVector)
+        self.assertEqual(len(copy.getConnectedComponents()), 1)
+        for simplex in copy.getSimplices():
+            simplex.validate()
+
+    def test_arrays_match_the_objects(self):
+        st = strip(slabs=3, seed=3)
+        vertices = st.getVertexList().toVector()
+        edges = st.getEdgeList().toVector()
+
+        ids = st.getVertexIdArray()
+        self.assertEqual(ids.tolist(), [v.getId() for v in vertices])
+        self.assertEqual(st.getTimeArray().tolist(), [v.getTime() for v in vertices])
+        coordinates = st.getCoordinateArray()
+        self.assertEqual(coordinates.shape[0], len(vertices))
+        self.assertEqual(coordinates[:, 0].tolist(), [v.getCoordinates()[0] for v in vertices])
+
+        endpoints = st.getEdgeArray()
+        self.assertEqual(endpoints.shape, (len(edges), 2))
+        self.assertEqual(endpoints.dtype.name, 'int64')
+        self.assertEqual([(ids[s], ids[t]) for s, t in endpoints.tolist()],
+                         [(e.getSourceId(), e.getTargetId()) for e in edges])
+        self.assertEqual(st.getSquaredLengthArray().tolist(), [e.getSquaredLength() for e in edges])
+
+        simplices = st.getSimplexArray()
+        self.assertEqual(simplices.shape, (st.getFaceCount(2), 3))
+        self.assertEqual(len({tuple(sorted(row)) for row in simplices.tolist()}), st.getFaceCount(2))
+        # The arrays own their memory, so they outlive the Spacetime.
+        del st
+        self.assertLess(simplices.max(), len(ids))
+
+    def test_from_arrays_round_trip(self):
+        st = strip(slabs=3, seed=7)
+        CDT(st).sweep(100)
+
+        imported = Spacetime.fromArrays(st.getTimeArray(), st.getSimplexArray())
+        self.assertEqual(imported.getFVector(), st.getFVector())
+        self.assertEqual(imported.getEulerCharacteristic(), st.getEulerCharacteristic())
+        self.assertEqual(imported.getSimplexCount((2, 1)), st.getSimplexCount((2, 1)))
+        self.assertEqual(imported.getSimplexCount((1, 2)), st.getSimplexCount((1, 2)))
+        for simplex in imported.getSimplices():
+            simplex.validate()
+        chain = CDT(imported)
+        chain.seed(1)
+        chain.sweep(100)
+        self.assertEqual(imported.getEulerCharacteristic(), st.getEulerCharacteristic())
+
+        # Rows that are not simplices of one slab, or facets shared three ways, are refused.
+        with self.assertRaises(ValueError):
+            Spacetime.fromArrays([0.0, 0.0, 0.0], [[0, 1, 2]])
+        with self.assertRaises(ValueError):
+            Spacetime.fromArrays([0.0, 0.0, 1.0, 1.0, 1.0], [[0, 1, 2], [0, 1, 3], [0, 1, 4]])
+        with self.assertRaises(ValueError):
+            Spacetime.fromArrays([0.0, 1.0], [[0, 1, 5]])
+
+    def test_checkpoint_round_trip(self):
+        st = strip(slabs=3, seed=5, stream=2)
+        CDT(st).sweep(200)
+
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, 'spacetime.ckpt')
+            st.save(path)
+            restored = Spacetime.load(path)
+
+            self.assertEqual(restored.getFVector(), st.getFVector())
+            self.assertEqual(restored.getSimplexCount((2, 1)), st.getSimplexCount((2, 1)))
+            self.assertEqual(restored.getEulerCharacteristic(), st.getEulerCharacteristic())
+            self.assertEqual(sorted(v.getId() for v in restored.getVertexList().toVector()),
+                             sorted(v.getId() for v in st.getVertexList().toVector()))
+            for simplex in restored.getSimplices():
+                simplex.validate()
+
+            # A restored chain continues exactly where the saved one left off.
+            chains = [CDT(st), CDT(restored)]
+            for chain in chains:
+                chain.seed(11)
+            self.assertEqual(chains[0].sweep(500), chains[1].sweep(500))
+            self.assertEqual(restored.getFVector(), st.getFVector())
+
+            # Damaged and missing files are refused rather than half-loaded.
+            with open(path, 'r+b') as f:
+                f.truncate(os.path.getsize(path) - 8)
+            with self.assertRaises(RuntimeError):
+                Spacetime.load(path)
+            with self.assertRaises(RuntimeError):
+                Spacetime.load(os.path.join(directory, 'missing.ckpt'))
+
 
 if __name__ == '__main__':
     unittest.main()
\ No newline at end of file
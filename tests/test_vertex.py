@@ -43,3 +43,17 @@ class TestVertex(unittest.TestCase):
         v1.removeOutEdge(edge)
         self.assertEqual(len(v1.getOutEdges()), 0)
 
+
+    def test_remove_inedge_keeps_remaining_edges(self):
+        st = Spacetime()
+        target = st.createVertex(0, [0, 0, 0, 0])
+        sources = [st.createVertex(i, [i, 0, 0, 0]) for i in range(1, 5)]
+        edges = [st.createEdge(source.getId(), target.getId()) for source in sources]
+
+        target.removeInEdge(edges[1])
+        self.assertEqual(sorted(e.getSourceId() for e in target.getInEdges()), [1, 3, 4])
+
+        target.removeInEdge(edges[0])
+        target.addInEdge(edges[3])
+        self.assertEqual(sorted(e.getSourceId() for e in target.getInEdges()), [3, 4])
+        self.assertEqual(target.degree(), 2)